@@ -0,0 +1,62 @@
+#include <whirl/clocks/posix.hpp>
+#include <whirl/clocks/tsc.hpp>
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstdint>
+
+using namespace whirl::clocks;  // NOLINT
+
+static const size_t kIterations = 10'000'000;
+
+template <typename F>
+void Measure(const char* name, F&& read) {
+  uint64_t checksum = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kIterations; ++i) {
+    checksum += read();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  double ns_per_call =
+      std::chrono::duration<double, std::nano>(elapsed).count() / kIterations;
+
+  fmt::print("{:<24} {:>8.2f} ns/call (checksum {})\n", name, ns_per_call,
+             checksum % 10);
+}
+
+int main() {
+  TscClock tsc;
+
+  fmt::print("TSC: invariant = {}, {:.3f} ticks/ns, calibration error = "
+             "{:.2f} ppm\n",
+             TscClock::IsInvariant(), tsc.TicksPerNano(), tsc.ErrorPpm());
+  fmt::print("Coarse clock resolution: {} ns\n\n", CoarseResolutionNanos());
+
+  Measure("rdtsc", []() {
+    return TscClock::ReadTicks();
+  });
+  Measure("TscClock::NowNanos", [&tsc]() {
+    return tsc.NowNanos();
+  });
+  Measure("CLOCK_MONOTONIC", []() {
+    return MonotonicNanos();
+  });
+  Measure("CLOCK_MONOTONIC_COARSE", []() {
+    return CoarseMonotonicNanos();
+  });
+  Measure("CLOCK_REALTIME", []() {
+    return WallNanos();
+  });
+  Measure("CLOCK_REALTIME_COARSE", []() {
+    return CoarseWallNanos();
+  });
+  Measure("std::chrono::steady_clock", []() {
+    return static_cast<uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+  });
+
+  return 0;
+}
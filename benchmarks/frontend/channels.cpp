@@ -0,0 +1,81 @@
+#include "stub_runtime.hpp"
+
+#include <whirl/node/cluster/peer.hpp>
+#include <whirl/node/rpc/random.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace whirl;  // NOLINT
+
+using await::futures::Future;
+
+using commute::rpc::CallOptions;
+using commute::rpc::IChannel;
+using commute::rpc::IChannelPtr;
+using commute::rpc::Message;
+using commute::rpc::Method;
+
+//////////////////////////////////////////////////////////////////////
+
+// Arg: pool size
+
+static void BM_PeerChannel(benchmark::State& state) {
+  benchmarks::StubRuntime runtime{static_cast<size_t>(state.range(0))};
+  runtime.Setup();
+
+  node::cluster::Peer peer{runtime.Config()};
+  auto hosts = peer.ListPeers().WithoutMe();
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(peer.Channel(hosts[i++ % hosts.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PeerChannel)->Arg(3)->Arg(5)->Arg(64);
+
+//////////////////////////////////////////////////////////////////////
+
+// Completes every call immediately
+class EchoChannel : public IChannel {
+ public:
+  Future<Message> Call(const Method& /*method*/, const Message& input,
+                       CallOptions /*options*/) override {
+    auto [future, promise] = await::futures::MakeContract<Message>();
+    std::move(promise).SetValue(input);
+    return std::move(future);
+  }
+
+  const std::string& Peer() const override {
+    return peer_;
+  }
+
+  void Close() override {
+  }
+
+ private:
+  const std::string peer_ = "echo";
+};
+
+// Arg: number of channels
+
+static void BM_RandomChannelCall(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+
+  std::vector<IChannelPtr> channels;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    channels.push_back(std::make_shared<EchoChannel>());
+  }
+  auto channel =
+      rpc::MakeRandomChannel(std::move(channels), runtime.RandomService());
+
+  const auto method = Method::Parse("Bench.Echo");
+  const Message input = "ping";
+
+  for (auto _ : state) {
+    auto future = channel->Call(method, input, CallOptions{});
+    benchmark::DoNotOptimize(future);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomChannelCall)->Arg(3)->Arg(64);
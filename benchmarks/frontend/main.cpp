@@ -0,0 +1,7 @@
+#include <benchmark/benchmark.h>
+
+// Machine-readable results for regression tracking:
+// whirl_frontend_benchmarks --benchmark_format=json
+//   --benchmark_out=results.json --benchmark_out_format=json
+
+BENCHMARK_MAIN();
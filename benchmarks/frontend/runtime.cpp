@@ -0,0 +1,147 @@
+#include "stub_runtime.hpp"
+
+#include <whirl/node/runtime/shortcuts.hpp>
+#include <whirl/node/runtime/fiber_pool.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace whirl;  // NOLINT
+using namespace whirl::node;  // NOLINT
+
+// Scheduled fibers run in batches: spawn + run cost per fiber
+static const size_t kRunEvery = 1024;
+
+//////////////////////////////////////////////////////////////////////
+
+static void BM_Go(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+
+  size_t completed = 0;
+  size_t spawned = 0;
+  for (auto _ : state) {
+    rt::Go([&completed]() {
+      ++completed;
+    });
+    if (++spawned % kRunEvery == 0) {
+      runtime.RunScheduled();
+    }
+  }
+  runtime.RunScheduled();
+
+  state.SetItemsProcessed(completed);
+}
+BENCHMARK(BM_Go);
+
+// Arg: batch size
+static void BM_GoBatch(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+
+  size_t completed = 0;
+  for (auto _ : state) {
+    std::vector<await::fibers::FiberRoutine> routines;
+    routines.reserve(state.range(0));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      routines.push_back([&completed]() {
+        ++completed;
+      });
+    }
+    rt::GoBatch(std::move(routines));
+    runtime.RunScheduled();
+  }
+
+  state.SetItemsProcessed(completed);
+}
+BENCHMARK(BM_GoBatch)->Arg(16)->Arg(256);
+
+static void BM_FiberPoolGo(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+
+  size_t completed = 0;
+  {
+    rt::FiberPool pool;
+    size_t spawned = 0;
+    for (auto _ : state) {
+      pool.Go([&completed]() {
+        ++completed;
+      });
+      if (++spawned % kRunEvery == 0) {
+        runtime.RunScheduled();
+      }
+    }
+    runtime.RunScheduled();
+
+    state.counters["hit_rate"] = pool.Counters().HitRate();
+  }
+  runtime.RunScheduled();
+
+  state.SetItemsProcessed(completed);
+}
+BENCHMARK(BM_FiberPoolGo);
+
+//////////////////////////////////////////////////////////////////////
+
+// Shortcut dispatch: thread-local runtime lookup + virtual call
+
+static void BM_GetRuntime(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&GetRuntime());
+  }
+}
+BENCHMARK(BM_GetRuntime);
+
+static void BM_WallTimeNowDirect(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  auto* clocks = runtime.TimeService();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(clocks->WallTimeNow());
+  }
+}
+BENCHMARK(BM_WallTimeNowDirect);
+
+static void BM_WallTimeNowShortcut(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rt::WallTimeNow());
+  }
+}
+BENCHMARK(BM_WallTimeNowShortcut);
+
+static void BM_RandomNumberShortcut(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rt::RandomNumber(100));
+  }
+}
+BENCHMARK(BM_RandomNumberShortcut);
+
+static void BM_NewGuidShortcut(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rt::NewGuid());
+  }
+}
+BENCHMARK(BM_NewGuidShortcut);
+
+static void BM_DatabaseShortcut(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  runtime.Setup();
+  rt::Database()->Put("key", "value");
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rt::Database()->TryGet("key"));
+  }
+}
+BENCHMARK(BM_DatabaseShortcut);
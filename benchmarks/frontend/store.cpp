@@ -0,0 +1,121 @@
+#include "stub_runtime.hpp"
+
+#include <whirl/node/store/kv.hpp>
+#include <whirl/node/store/struct.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/core.h>
+
+#include <string>
+#include <vector>
+
+using namespace whirl;  // NOLINT
+
+static std::vector<std::string> MakeKeys(size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    keys.push_back(fmt::format("key-{}", i));
+  }
+  return keys;
+}
+
+// Arg: number of distinct keys
+
+//////////////////////////////////////////////////////////////////////
+
+static void BM_KVStorePut(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  node::store::KVStore<int64_t> kv{runtime.Database(), "bench"};
+  auto keys = MakeKeys(state.range(0));
+
+  size_t i = 0;
+  for (auto _ : state) {
+    kv.Put(keys[i % keys.size()], static_cast<int64_t>(i));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KVStorePut)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_KVStoreGet(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  node::store::KVStore<std::string> kv{runtime.Database(), "bench"};
+  auto keys = MakeKeys(state.range(0));
+  for (const auto& key : keys) {
+    kv.Put(key, std::string(64, 'v'));
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kv.Get(keys[i++ % keys.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KVStoreGet)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_KVStoreHas(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  node::store::KVStore<std::string> kv{runtime.Database(), "bench"};
+  auto keys = MakeKeys(state.range(0));
+  // Half of the lookups miss
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    kv.Put(keys[i], std::string(64, 'v'));
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kv.Has(keys[i++ % keys.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KVStoreHas)->Arg(1 << 10)->Arg(1 << 16);
+
+//////////////////////////////////////////////////////////////////////
+
+static void BM_StructStoreStore(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  node::store::StructStore store{runtime.Database()};
+  auto keys = MakeKeys(state.range(0));
+
+  size_t i = 0;
+  for (auto _ : state) {
+    store.Store<uint64_t>(keys[i % keys.size()], i);
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StructStoreStore)->Arg(1 << 10);
+
+static void BM_StructStoreLoad(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  node::store::StructStore store{runtime.Database()};
+  auto keys = MakeKeys(state.range(0));
+  for (const auto& key : keys) {
+    store.Store<uint64_t>(key, 42);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(store.Load<uint64_t>(keys[i++ % keys.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StructStoreLoad)->Arg(1 << 10);
+
+static void BM_StructStoreHas(benchmark::State& state) {
+  benchmarks::StubRuntime runtime;
+  node::store::StructStore store{runtime.Database()};
+  auto keys = MakeKeys(state.range(0));
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    store.Store<uint64_t>(keys[i], 42);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(store.Has(keys[i++ % keys.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StructStoreHas)->Arg(1 << 10);
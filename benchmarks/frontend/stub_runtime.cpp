@@ -0,0 +1,282 @@
+#include "stub_runtime.hpp"
+
+#include <whirl/runtime/access.hpp>
+
+#include <await/fibers/static/services.hpp>
+#include <await/futures/core/future.hpp>
+
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+#include <cstdlib>
+
+using namespace whirl::node;  // NOLINT
+
+namespace whirl::benchmarks {
+
+const std::string StubRuntime::kHostName = "bench-0";
+const std::string StubRuntime::kPoolName = "bench";
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+class StubTimeService : public time::ITimeService {
+ public:
+  time::WallTime WallTimeNow() override {
+    return Jiffies{++now_};
+  }
+
+  time::MonotonicTime MonotonicNow() override {
+    return Jiffies{++now_};
+  }
+
+  await::futures::Future<void> After(await::time::Jiffies /*d*/) override {
+    auto [future, promise] = await::futures::MakeContract<void>();
+    std::move(promise).SetValue();
+    return std::move(future);
+  }
+
+  // Fires immediately: nothing to cancel
+  time::CancellableTimer ArmTimer(Jiffies delay) override {
+    return {After(delay), []() {}};
+  }
+
+ private:
+  uint64_t now_ = 0;
+};
+
+class StubTrueTime : public time::ITrueTimeService {
+ public:
+  explicit StubTrueTime(time::ITimeService* clocks) : clocks_(clocks) {
+  }
+
+  time::TTInterval Now() const override {
+    auto now = clocks_->WallTimeNow();
+    return {now, now + 10};
+  }
+
+ private:
+  time::ITimeService* clocks_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class NullSocket : public commute::transport::ISocket {
+ public:
+  explicit NullSocket(std::string peer) : peer_(std::move(peer)) {
+  }
+
+  const std::string& Peer() const override {
+    return peer_;
+  }
+
+  void Send(const commute::transport::Message& /*message*/) override {
+  }
+
+  void Close() override {
+  }
+
+  bool IsConnected() const override {
+    return true;
+  }
+
+ private:
+  std::string peer_;
+};
+
+class NullServer : public commute::transport::IServer {
+ public:
+  void Shutdown() override {
+  }
+};
+
+class NullTransport : public commute::transport::ITransport {
+ public:
+  const std::string& HostName() const override {
+    return StubRuntime::kHostName;
+  }
+
+  commute::transport::IServerPtr Serve(
+      const std::string& /*port*/,
+      commute::transport::IHandlerPtr /*handler*/) override {
+    return std::make_shared<NullServer>();
+  }
+
+  commute::transport::ISocketPtr ConnectTo(
+      const std::string& address,
+      commute::transport::IHandlerPtr /*handler*/) override {
+    return std::make_shared<NullSocket>(address);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class MapConfig : public cfg::IConfig {
+ public:
+  MapConfig()
+      : strings_{{"pool.name", StubRuntime::kPoolName}},
+        ints_{{"rpc.port", 42},
+              {"rpc.backoff.init", 1},
+              {"rpc.backoff.max", 100},
+              {"rpc.backoff.factor", 2}} {
+  }
+
+  std::string GetString(cfg::Key key) const override {
+    return Find(strings_, key);
+  }
+
+  int64_t GetInt64(cfg::Key key) const override {
+    return Find(ints_, key);
+  }
+
+  bool GetBool(cfg::Key key) const override {
+    return Find(ints_, key) != 0;
+  }
+
+ private:
+  template <typename T>
+  static T Find(const std::map<std::string, T, std::less<>>& values,
+                cfg::Key key) {
+    auto it = values.find(key);
+    if (it == values.end()) {
+      WHEELS_PANIC(fmt::format("Config key '{}' not found", key));
+    }
+    return it->second;
+  }
+
+ private:
+  std::map<std::string, std::string, std::less<>> strings_;
+  std::map<std::string, int64_t, std::less<>> ints_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class MallocAllocator : public memory::IAllocator {
+ public:
+  void* Allocate(size_t size) override {
+    return std::malloc(size);
+  }
+
+  void Deallocate(void* ptr, size_t /*size*/) override {
+    std::free(ptr);
+  }
+};
+
+class NullLogBackend : public timber::ILogBackend {
+ public:
+  timber::Level GetMinLevelFor(
+      const std::string& /*component*/) const override {
+    return timber::Level::Off;
+  }
+
+  void Log(timber::Event /*event*/) override {
+  }
+};
+
+class NullTerminal : public ITerminal {
+ public:
+  void PrintLine(std::string_view /*line*/) override {
+  }
+};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+struct StubRuntime::Services {
+  StubTimeService time;
+  StubTrueTime true_time{&time};
+  NullTransport transport;
+  MapConfig config;
+  MallocAllocator allocator;
+  NullLogBackend logger;
+  NullTerminal terminal;
+};
+
+StubRuntime::StubRuntime(size_t pool_size)
+    : services_(std::make_unique<Services>()) {
+  cluster::List pool;
+  pool.push_back(kHostName);
+  for (size_t i = 1; i < pool_size; ++i) {
+    pool.push_back(fmt::format("bench-{}", i));
+  }
+  membership_.Update(kPoolName, std::move(pool));
+}
+
+StubRuntime::~StubRuntime() {
+  ResetRuntime();
+}
+
+void StubRuntime::Setup() {
+  SetupRuntime([this]() -> IRuntime& {
+    return *this;
+  });
+}
+
+void StubRuntime::RunScheduled() {
+  executor_.Drain();
+}
+
+await::executors::IExecutor* StubRuntime::Executor() {
+  return &executor_;
+}
+
+await::fibers::IFiberManager* StubRuntime::FiberManager() {
+  return await::fibers::StaticFiberManager();
+}
+
+time::ITimeService* StubRuntime::TimeService() {
+  return &services_->time;
+}
+
+time::ITrueTimeService* StubRuntime::TrueTime() {
+  return &services_->true_time;
+}
+
+persist::fs::IFileSystem* StubRuntime::FileSystem() {
+  WHEELS_PANIC("File system is not available in benchmarks");
+}
+
+db::IDatabase* StubRuntime::Database() {
+  return &db_;
+}
+
+memory::IAllocator* StubRuntime::Allocator() {
+  return &services_->allocator;
+}
+
+commute::transport::ITransport* StubRuntime::NetTransport() {
+  return &services_->transport;
+}
+
+cluster::IDiscoveryService* StubRuntime::DiscoveryService() {
+  return &membership_;
+}
+
+timber::ILogBackend* StubRuntime::LoggerBackend() {
+  return &services_->logger;
+}
+
+random::IRandomService* StubRuntime::RandomService() {
+  return &random_;
+}
+
+guids::IGuidGenerator* StubRuntime::GuidGenerator() {
+  return &guids_;
+}
+
+cfg::IConfig* StubRuntime::Config() {
+  return &services_->config;
+}
+
+ITerminal* StubRuntime::Terminal() {
+  return &services_->terminal;
+}
+
+RuntimeLocals* StubRuntime::Locals() {
+  return &locals_;
+}
+
+}  // namespace whirl::benchmarks
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <whirl/runtime/runtime.hpp>
+
+#include <whirl/node/cluster/membership.hpp>
+#include <whirl/node/db/memory.hpp>
+#include <whirl/node/guids/generator.hpp>
+#include <whirl/node/random/stream.hpp>
+
+#include <await/executors/manual.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace whirl::benchmarks {
+
+// Minimal in-process runtime for microbenchmarks
+//
+// - Manual executor: scheduled fibers run in RunScheduled
+// - Clocks advance by one jiffy per read, timers fire immediately
+// - In-memory database
+// - Transport drops all messages: channels can be created and looked up,
+//   calls never complete
+
+class StubRuntime : public node::IRuntime {
+ public:
+  static const std::string kHostName;
+  static const std::string kPoolName;
+
+  explicit StubRuntime(size_t pool_size = 5);
+  ~StubRuntime();
+
+  // Binds this runtime to the current thread
+  void Setup();
+
+  // Runs scheduled fibers to completion
+  void RunScheduled();
+
+  node::cluster::Membership& Membership() {
+    return membership_;
+  }
+
+  // IRuntime
+
+  await::executors::IExecutor* Executor() override;
+  await::fibers::IFiberManager* FiberManager() override;
+
+  node::time::ITimeService* TimeService() override;
+  node::time::ITrueTimeService* TrueTime() override;
+
+  persist::fs::IFileSystem* FileSystem() override;
+  node::db::IDatabase* Database() override;
+
+  node::memory::IAllocator* Allocator() override;
+
+  commute::transport::ITransport* NetTransport() override;
+
+  node::cluster::IDiscoveryService* DiscoveryService() override;
+
+  timber::ILogBackend* LoggerBackend() override;
+
+  node::random::IRandomService* RandomService() override;
+
+  node::guids::IGuidGenerator* GuidGenerator() override;
+
+  node::cfg::IConfig* Config() override;
+
+  node::ITerminal* Terminal() override;
+
+  node::RuntimeLocals* Locals() override;
+
+ private:
+  struct Services;
+
+  await::executors::ManualExecutor executor_;
+  node::db::MemoryDatabase db_;
+  node::random::Stream random_{42};
+  node::guids::Generator guids_{1};
+  node::cluster::Membership membership_;
+  node::RuntimeLocals locals_;
+  std::unique_ptr<Services> services_;
+};
+
+}  // namespace whirl::benchmarks
@@ -0,0 +1,61 @@
+#include <whirl/node/db/write_batch.hpp>
+
+#include <muesli/serialize.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/core.h>
+
+#include <string>
+#include <vector>
+
+using namespace whirl::node;  // NOLINT
+
+// Arg: mutations per batch
+
+static db::WriteBatch MakeBatch(const std::vector<std::string>& keys,
+                                const std::string& value) {
+  db::WriteBatch batch;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i % 4 == 3) {
+      batch.Delete(keys[i]);
+    } else {
+      batch.Put(keys[i], value);
+    }
+  }
+  return batch;
+}
+
+static std::vector<std::string> MakeKeys(size_t count) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < count; ++i) {
+    keys.push_back(fmt::format("kv:bench:key-{}", i));
+  }
+  return keys;
+}
+
+static void BM_WriteBatchBuild(benchmark::State& state) {
+  auto keys = MakeKeys(state.range(0));
+  const std::string value(64, 'v');
+
+  for (auto _ : state) {
+    auto batch = MakeBatch(keys, value);
+    benchmark::DoNotOptimize(batch.muts.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteBatchBuild)->Arg(1)->Arg(16)->Arg(256);
+
+static void BM_WriteBatchSerialize(benchmark::State& state) {
+  auto batch = MakeBatch(MakeKeys(state.range(0)), std::string(64, 'v'));
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto serialized = muesli::Serialize(batch.muts);
+    bytes += serialized.size();
+    benchmark::DoNotOptimize(serialized.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_WriteBatchSerialize)->Arg(1)->Arg(16)->Arg(256);
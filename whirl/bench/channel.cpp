@@ -0,0 +1,49 @@
+#include <whirl/bench/channel.hpp>
+
+using await::futures::Future;
+
+using commute::rpc::CallOptions;
+using commute::rpc::IChannel;
+using commute::rpc::IChannelPtr;
+using commute::rpc::Message;
+using commute::rpc::Method;
+
+namespace whirl::bench {
+
+//////////////////////////////////////////////////////////////////////
+
+class ModeledChannel : public IChannel {
+ public:
+  ModeledChannel(IChannelPtr channel, RpcModel model, NodeResources* node)
+      : channel_(std::move(channel)), model_(model), node_(node) {
+  }
+
+  Future<Message> Call(const Method& method, const Message& input,
+                       CallOptions options) override {
+    node_->cpu.Use(model_.call_cost);
+    node_->net.Use(TransferTime(input.size(), model_.bytes_per_jiffy));
+    return channel_->Call(method, input, std::move(options));
+  }
+
+  const std::string& Peer() const override {
+    return channel_->Peer();
+  }
+
+  void Close() override {
+    channel_->Close();
+  }
+
+ private:
+  IChannelPtr channel_;
+  const RpcModel model_;
+  NodeResources* node_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+IChannelPtr MakeModeledChannel(IChannelPtr channel, RpcModel model,
+                               NodeResources* node) {
+  return std::make_shared<ModeledChannel>(std::move(channel), model, node);
+}
+
+}  // namespace whirl::bench
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <whirl/bench/costs.hpp>
+#include <whirl/bench/resource.hpp>
+
+#include <commute/rpc/channel.hpp>
+
+namespace whirl::bench {
+
+// Pays modeled client CPU cost (on `node.cpu`) and request transfer time
+// (on `node.net`) in simulated time before each call
+// Server side is modeled by MakeModeledTransport
+// Must be used from fibers
+commute::rpc::IChannelPtr MakeModeledChannel(commute::rpc::IChannelPtr channel,
+                                             RpcModel model,
+                                             NodeResources* node);
+
+}  // namespace whirl::bench
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+
+#include <cstdint>
+
+namespace whirl::bench {
+
+// Modeled costs for benchmark mode
+// Costs are paid by sleeping in simulated time on per-node resources
+// (see resource.hpp), so protocol throughput / latency under load can be
+// estimated deterministically
+
+struct DiskModel {
+  // Per-operation latency
+  Jiffies read_latency = 0;
+  Jiffies write_latency = 0;
+  // Paid by each durable write (Put / Delete / Write)
+  Jiffies sync_latency = 0;
+  Jiffies snapshot_latency = 0;
+
+  // 0 - unlimited
+  uint64_t bytes_per_jiffy = 0;
+};
+
+struct RpcModel {
+  // Client CPU cost (serialization, syscalls, etc) per call
+  Jiffies call_cost = 0;
+  // Server CPU cost (deserialization, dispatch, etc) per request,
+  // see MakeModeledTransport
+  Jiffies handle_cost = 0;
+
+  // 0 - unlimited
+  uint64_t bytes_per_jiffy = 0;
+};
+
+struct CostModel {
+  DiskModel disk;
+  RpcModel rpc;
+};
+
+// Time to transfer `bytes` with given bandwidth
+inline Jiffies TransferTime(size_t bytes, uint64_t bytes_per_jiffy) {
+  if (bytes_per_jiffy == 0) {
+    return 0;
+  }
+  return (bytes + bytes_per_jiffy - 1) / bytes_per_jiffy;
+}
+
+}  // namespace whirl::bench
@@ -0,0 +1,95 @@
+#include <whirl/bench/database.hpp>
+
+using whirl::node::db::IDatabase;
+using whirl::node::db::ISnapshotPtr;
+using whirl::node::db::Key;
+using whirl::node::db::MutationType;
+using whirl::node::db::Value;
+using whirl::node::db::WriteBatch;
+
+namespace whirl::bench {
+
+//////////////////////////////////////////////////////////////////////
+
+class ModeledDatabase : public IDatabase {
+ public:
+  ModeledDatabase(IDatabase* db, DiskModel model, Resource* disk)
+      : db_(db), model_(model), disk_(disk) {
+  }
+
+  void Open(const std::string& directory) override {
+    db_->Open(directory);
+  }
+
+  void Put(const Key& key, const Value& value) override {
+    Pay(model_.write_latency + model_.sync_latency +
+        Transfer(key.size() + value.size()));
+    db_->Put(key, value);
+  }
+
+  std::optional<Value> TryGet(const Key& key) const override {
+    auto value = db_->TryGet(key);
+    Pay(model_.read_latency +
+        Transfer(key.size() + (value.has_value() ? value->size() : 0)));
+    return value;
+  }
+
+  void Delete(const Key& key) override {
+    Pay(model_.write_latency + model_.sync_latency + Transfer(key.size()));
+    db_->Delete(key);
+  }
+
+  void Merge(const Key& key, const Value& operand) override {
+    Pay(model_.write_latency + model_.sync_latency +
+        Transfer(key.size() + operand.size()));
+    db_->Merge(key, operand);
+  }
+
+  bool SupportsMerge() const override {
+    return db_->SupportsMerge();
+  }
+
+  void Write(WriteBatch batch) override {
+    VerifyMergeSupport(*db_, batch);
+    size_t bytes = 0;
+    for (const auto& mut : batch.muts) {
+      bytes += mut.key.size();
+      if (mut.type != MutationType::Delete) {
+        bytes += mut.value->size();
+      }
+    }
+    // Single sync for the whole batch
+    Pay(model_.write_latency * batch.muts.size() + model_.sync_latency +
+        Transfer(bytes));
+    db_->Write(std::move(batch));
+  }
+
+  ISnapshotPtr MakeSnapshot() override {
+    Pay(model_.snapshot_latency);
+    return db_->MakeSnapshot();
+  }
+
+ private:
+  Jiffies Transfer(size_t bytes) const {
+    return TransferTime(bytes, model_.bytes_per_jiffy);
+  }
+
+  void Pay(Jiffies cost) const {
+    disk_->Use(cost);
+  }
+
+ private:
+  IDatabase* db_;
+  const DiskModel model_;
+  Resource* disk_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<IDatabase> MakeModeledDatabase(IDatabase* db,
+                                               DiskModel model,
+                                               Resource* disk) {
+  return std::make_unique<ModeledDatabase>(db, model, disk);
+}
+
+}  // namespace whirl::bench
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <whirl/bench/costs.hpp>
+#include <whirl/bench/resource.hpp>
+
+#include <whirl/node/db/database.hpp>
+
+#include <memory>
+
+namespace whirl::bench {
+
+// Pays modeled disk costs in simulated time before each operation
+// Operations of the node queue up on its `disk`
+// Must be used from fibers
+std::unique_ptr<node::db::IDatabase> MakeModeledDatabase(
+    node::db::IDatabase* db, DiskModel model, Resource* disk);
+
+}  // namespace whirl::bench
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <whirl/bench/stats.hpp>
+
+#include <whirl/node/runtime/shortcuts.hpp>
+
+namespace whirl::bench {
+
+// Usage: auto value = Measure(stats, [&]() { return kv.Get(key); });
+template <typename F>
+decltype(auto) Measure(Stats& stats, F&& operation) {
+  struct Guard {
+    Stats& stats;
+    node::time::MonotonicTime start;
+
+    ~Guard() {
+      stats.Add(node::rt::MonotonicNow() - start);
+    }
+  } guard{stats, node::rt::MonotonicNow()};
+
+  return operation();
+}
+
+}  // namespace whirl::bench
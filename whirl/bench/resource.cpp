@@ -0,0 +1,32 @@
+#include <whirl/bench/resource.hpp>
+
+#include <whirl/node/runtime/shortcuts.hpp>
+
+#include <algorithm>
+
+namespace whirl::bench {
+
+void Resource::Use(Jiffies cost) {
+  if (cost == 0) {
+    return;
+  }
+
+  Jiffies delay = Reserve(node::rt::MonotonicNow().ToJiffies(), cost);
+  node::rt::SleepFor(delay);
+}
+
+Jiffies Resource::Reserve(Jiffies now, Jiffies cost) {
+  if (now < last_now_) {
+    // Node restarted: queue of the previous incarnation is gone
+    busy_until_ = 0;
+  }
+  last_now_ = now;
+
+  // Operation slot: [start, start + cost)
+  Jiffies start = std::max(now, busy_until_);
+  busy_until_ = start + cost;
+
+  return busy_until_ - now;
+}
+
+}  // namespace whirl::bench
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+#include <whirl/node/time/monotonic_time.hpp>
+
+namespace whirl::bench {
+
+// Serially used resource of a single node: CPU, disk, network link
+// Operations queue up: each one starts when the previous one is done,
+// so concurrent operations contend instead of overlapping for free
+// Time is node monotonic time: queue is dropped when the clock goes
+// back (node restart), engine may also Reset it explicitly
+// Not thread-safe: belongs to a single node
+
+class Resource {
+ public:
+  // Occupies resource for `cost` and blocks current fiber until
+  // the operation completes (queueing delay + cost)
+  // Must be called from fibers
+  void Use(Jiffies cost);
+
+  // Occupies resource for `cost` starting from `now`,
+  // returns delay until the operation completes
+  Jiffies Reserve(Jiffies now, Jiffies cost);
+
+  // Monotonic time when all queued operations are done
+  node::time::MonotonicTime BusyUntil() const {
+    return busy_until_;
+  }
+
+  // Drops queued operations, e.g. on node restart
+  void Reset() {
+    busy_until_ = 0;
+    last_now_ = 0;
+  }
+
+ private:
+  Jiffies busy_until_ = 0;
+  // Detects restarts of the monotonic clock
+  Jiffies last_now_ = 0;
+};
+
+// Modeled resources of a single node, shared by all its
+// modeled databases, channels and transports
+
+struct NodeResources {
+  Resource cpu;
+  Resource disk;
+  Resource net;
+
+  void Reset() {
+    cpu.Reset();
+    disk.Reset();
+    net.Reset();
+  }
+};
+
+}  // namespace whirl::bench
@@ -0,0 +1,53 @@
+#include <whirl/bench/stats.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace whirl::bench {
+
+// Nearest-rank percentile, `sorted` is not empty
+static Jiffies Percentile(const std::vector<Jiffies::ValueType>& sorted,
+                          double p) {
+  // Smallest value covering at least p * n samples
+  // (epsilon absorbs rounding of p * n, e.g. 0.99 * 100)
+  auto rank = static_cast<size_t>(std::ceil(p * sorted.size() - 1e-9));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+Report Stats::MakeReport(node::time::MonotonicTime now) const {
+  Report report;
+  report.operations = latencies_.size();
+  report.duration = now - start_;
+
+  if (latencies_.empty()) {
+    return report;
+  }
+
+  if (report.duration.Count() > 0) {
+    report.throughput =
+        static_cast<double>(report.operations) / report.duration.Count();
+  }
+
+  auto sorted = latencies_;
+  std::sort(sorted.begin(), sorted.end());
+
+  report.p50 = Percentile(sorted, 0.5);
+  report.p90 = Percentile(sorted, 0.9);
+  report.p99 = Percentile(sorted, 0.99);
+  report.p999 = Percentile(sorted, 0.999);
+  report.max = sorted.back();
+
+  return report;
+}
+
+std::string Report::ToString() const {
+  return fmt::format(
+      "{} ops in {} jfs, throughput: {:.4f} ops/jf, latency: p50 = {}, "
+      "p90 = {}, p99 = {}, p99.9 = {}, max = {}",
+      operations, duration.Count(), throughput, p50.Count(), p90.Count(),
+      p99.Count(), p999.Count(), max.Count());
+}
+
+}  // namespace whirl::bench
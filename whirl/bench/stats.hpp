@@ -0,0 +1,52 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+#include <whirl/node/time/monotonic_time.hpp>
+
+#include <string>
+#include <vector>
+
+namespace whirl::bench {
+
+struct Report {
+  size_t operations = 0;
+  // Simulated time covered by the report
+  Jiffies duration = 0;
+  // Operations per jiffy
+  double throughput = 0;
+
+  // Latency percentiles
+  Jiffies p50 = 0;
+  Jiffies p90 = 0;
+  Jiffies p99 = 0;
+  Jiffies p999 = 0;
+  Jiffies max = 0;
+
+  std::string ToString() const;
+};
+
+// Collects operation latencies of a single simulated run
+
+class Stats {
+ public:
+  // Starts measured interval
+  void Start(node::time::MonotonicTime now) {
+    start_ = now;
+  }
+
+  void Add(Jiffies latency) {
+    latencies_.push_back(latency.Count());
+  }
+
+  size_t Count() const {
+    return latencies_.size();
+  }
+
+  Report MakeReport(node::time::MonotonicTime now) const;
+
+ private:
+  node::time::MonotonicTime start_{0};
+  std::vector<Jiffies::ValueType> latencies_;
+};
+
+}  // namespace whirl::bench
@@ -0,0 +1,108 @@
+#include <whirl/bench/transport.hpp>
+
+#include <whirl/node/runtime/shortcuts.hpp>
+
+using commute::transport::IHandler;
+using commute::transport::IHandlerPtr;
+using commute::transport::IServerPtr;
+using commute::transport::ISocketPtr;
+using commute::transport::ITransport;
+using commute::transport::Message;
+
+using whirl::node::time::ITimeService;
+
+namespace whirl::bench {
+
+//////////////////////////////////////////////////////////////////////
+
+class ModeledHandler : public IHandler {
+ public:
+  ModeledHandler(IHandlerPtr handler, RpcModel model, NodeResources* node,
+                 ITimeService* time)
+      : handler_(std::move(handler)), model_(model), node_(node), time_(time) {
+  }
+
+  void HandleMessage(const Message& message, ISocketPtr back) override {
+    Deliver(model_.handle_cost,
+            [handler = handler_, message, back = std::move(back)]() {
+              handler->HandleMessage(message, back);
+            });
+  }
+
+  void HandleDisconnect(const std::string& peer) override {
+    Deliver(0, [handler = handler_, peer]() {
+      handler->HandleDisconnect(peer);
+    });
+  }
+
+ private:
+  // Delivered in order: completion times of reservations do not decrease
+  template <typename F>
+  void Deliver(Jiffies cost, F deliver) {
+    Jiffies now = time_->MonotonicNow().ToJiffies();
+    Jiffies delay = node_->cpu.Reserve(now, cost);
+
+    if (delay == 0) {
+      deliver();
+      return;
+    }
+
+    time_->After(delay).Subscribe(
+        [deliver = std::move(deliver)](wheels::Result<void> result) mutable {
+          if (result.IsOk()) {
+            deliver();
+          }
+        });
+  }
+
+ private:
+  IHandlerPtr handler_;
+  const RpcModel model_;
+  NodeResources* node_;
+  ITimeService* time_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class ModeledTransport : public ITransport {
+ public:
+  ModeledTransport(ITransport* transport, RpcModel model, NodeResources* node)
+      : transport_(transport),
+        model_(model),
+        node_(node),
+        time_(node::rt::TimeService()) {
+  }
+
+  const std::string& HostName() const override {
+    return transport_->HostName();
+  }
+
+  IServerPtr Serve(const std::string& port, IHandlerPtr handler) override {
+    return transport_->Serve(
+        port, std::make_shared<ModeledHandler>(std::move(handler), model_,
+                                               node_, time_));
+  }
+
+  // Responses are paid for by the caller (MakeModeledChannel)
+  ISocketPtr ConnectTo(const std::string& address,
+                       IHandlerPtr handler) override {
+    return transport_->ConnectTo(address, std::move(handler));
+  }
+
+ private:
+  ITransport* transport_;
+  const RpcModel model_;
+  NodeResources* node_;
+  // Cached: messages are delivered outside of node fibers
+  ITimeService* time_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<ITransport> MakeModeledTransport(ITransport* transport,
+                                                 RpcModel model,
+                                                 NodeResources* node) {
+  return std::make_unique<ModeledTransport>(transport, model, node);
+}
+
+}  // namespace whirl::bench
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <whirl/bench/costs.hpp>
+#include <whirl/bench/resource.hpp>
+
+#include <commute/transport/transport.hpp>
+
+#include <memory>
+
+namespace whirl::bench {
+
+// Pays modeled server CPU cost (RpcModel::handle_cost on `node.cpu`)
+// for every message received by servers (Serve): delivery is delayed
+// until the request is processed, requests queue up behind each other
+// and behind client calls of the node
+// Disconnects are delivered after queued messages
+//
+// Usage: RPC server of the node is made on top of the returned transport
+// Must be created in node context
+
+std::unique_ptr<commute::transport::ITransport> MakeModeledTransport(
+    commute::transport::ITransport* transport, RpcModel model,
+    NodeResources* node);
+
+}  // namespace whirl::bench
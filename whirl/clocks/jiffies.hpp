@@ -0,0 +1,39 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+#include <whirl/node/time/monotonic_time.hpp>
+#include <whirl/node/time/wall_time.hpp>
+
+#include <cstdint>
+
+namespace whirl::clocks {
+
+// Maps real nanoseconds to jiffies: 1 jiffy = `nanos_per_jiffy` ns
+
+class JiffiesScale {
+ public:
+  explicit JiffiesScale(uint64_t nanos_per_jiffy)
+      : nanos_per_jiffy_(nanos_per_jiffy) {
+  }
+
+  Jiffies FromNanos(uint64_t nanos) const {
+    return nanos / nanos_per_jiffy_;
+  }
+
+  uint64_t ToNanos(Jiffies jfs) const {
+    return jfs.Count() * nanos_per_jiffy_;
+  }
+
+  node::time::MonotonicTime ToMonotonic(uint64_t nanos) const {
+    return FromNanos(nanos);
+  }
+
+  node::time::WallTime ToWall(uint64_t nanos) const {
+    return FromNanos(nanos);
+  }
+
+ private:
+  uint64_t nanos_per_jiffy_;
+};
+
+}  // namespace whirl::clocks
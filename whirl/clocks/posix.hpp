@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ctime>
+#include <cstdint>
+
+namespace whirl::clocks {
+
+// clock_gettime-based sources, served by vDSO (no syscall) on Linux
+
+namespace detail {
+
+inline uint64_t ReadNanos(clockid_t clock) {
+  timespec ts;
+  clock_gettime(clock, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+}  // namespace detail
+
+// Precise, ~20ns per call
+inline uint64_t MonotonicNanos() {
+  return detail::ReadNanos(CLOCK_MONOTONIC);
+}
+
+inline uint64_t WallNanos() {
+  return detail::ReadNanos(CLOCK_REALTIME);
+}
+
+// Coarse: value of the last scheduler tick, few ns per call
+// Error bound: CoarseResolutionNanos (1-4ms depending on CONFIG_HZ)
+inline uint64_t CoarseMonotonicNanos() {
+  return detail::ReadNanos(CLOCK_MONOTONIC_COARSE);
+}
+
+inline uint64_t CoarseWallNanos() {
+  return detail::ReadNanos(CLOCK_REALTIME_COARSE);
+}
+
+inline uint64_t CoarseResolutionNanos() {
+  timespec ts;
+  clock_getres(CLOCK_MONOTONIC_COARSE, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+}  // namespace whirl::clocks
@@ -0,0 +1,79 @@
+#include <whirl/clocks/tsc.hpp>
+#include <whirl/clocks/posix.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#if defined(WHIRL_CLOCKS_HAS_TSC)
+#include <cpuid.h>
+#endif
+
+namespace whirl::clocks {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Pair of readings taken as close to each other as possible
+struct Sample {
+  uint64_t ticks;
+  uint64_t nanos;
+  // Width of the bracketing interval
+  uint64_t uncertainty;
+};
+
+Sample TakeSample() {
+  static const int kAttempts = 16;
+
+  Sample best{0, 0, UINT64_MAX};
+  for (int i = 0; i < kAttempts; ++i) {
+    uint64_t before = MonotonicNanos();
+    uint64_t ticks = TscClock::ReadTicks();
+    uint64_t after = MonotonicNanos();
+
+    if (after - before < best.uncertainty) {
+      best = {ticks, before + (after - before) / 2, after - before};
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+bool TscClock::IsInvariant() {
+#if defined(WHIRL_CLOCKS_HAS_TSC)
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  return (edx & (1 << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+TscClock::TscClock(Params params) {
+  WHEELS_VERIFY(params.calibration_nanos > 0, "Empty calibration interval");
+
+  Sample start = TakeSample();
+  while (MonotonicNanos() - start.nanos < params.calibration_nanos) {
+    // Busy wait
+  }
+  Sample end = TakeSample();
+
+  uint64_t ticks = end.ticks - start.ticks;
+  uint64_t nanos = end.nanos - start.nanos;
+  WHEELS_VERIFY(ticks > 0, "TSC does not advance");
+
+  base_ticks_ = end.ticks;
+  base_nanos_ = end.nanos;
+  mult_ = static_cast<uint64_t>((static_cast<__uint128_t>(nanos) << kShift) /
+                                ticks);
+
+  ticks_per_nano_ = static_cast<double>(ticks) / nanos;
+  error_ppm_ = 1e6 * static_cast<double>(start.uncertainty + end.uncertainty) /
+               nanos;
+}
+
+}  // namespace whirl::clocks
@@ -0,0 +1,80 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define WHIRL_CLOCKS_HAS_TSC 1
+#else
+#include <whirl/clocks/posix.hpp>
+#endif
+
+#include <cstdint>
+
+namespace whirl::clocks {
+
+// Monotonic clock on top of time stamp counter, few ns per call
+// Calibrated against CLOCK_MONOTONIC and anchored to it, so readings are
+// comparable with MonotonicNanos
+//
+// Requires invariant TSC (constant rate, synchronized across cores)
+// On non-x86 targets ticks are CLOCK_MONOTONIC nanoseconds:
+// same interface, no speedup, IsInvariant() == false
+// Error bound: drift of ErrorPpm parts per million relative to
+// CLOCK_MONOTONIC, dominated by calibration interval
+
+class TscClock {
+ public:
+  struct Params {
+    uint64_t calibration_nanos = 20'000'000;  // 20ms
+  };
+
+  explicit TscClock(Params params);
+
+  TscClock() : TscClock(Params{}) {
+  }
+
+  static bool IsInvariant();
+
+  static uint64_t ReadTicks() {
+#if defined(WHIRL_CLOCKS_HAS_TSC)
+    return __rdtsc();
+#else
+    return MonotonicNanos();
+#endif
+  }
+
+  uint64_t NowNanos() const {
+    return TicksToNanos(ReadTicks());
+  }
+
+  // Ticks read before the end of calibration (e.g. on another core)
+  // are clamped to the calibration point
+  uint64_t TicksToNanos(uint64_t ticks) const {
+    if (ticks < base_ticks_) {
+      return base_nanos_;
+    }
+    __uint128_t delta = ticks - base_ticks_;
+    return base_nanos_ + static_cast<uint64_t>((delta * mult_) >> kShift);
+  }
+
+  double TicksPerNano() const {
+    return ticks_per_nano_;
+  }
+
+  // Estimated relative error of calibration, parts per million
+  double ErrorPpm() const {
+    return error_ppm_;
+  }
+
+ private:
+  static const int kShift = 32;
+
+  uint64_t base_ticks_;
+  uint64_t base_nanos_;
+  // Nanos per tick, fixed point with kShift fractional bits
+  uint64_t mult_;
+
+  double ticks_per_nano_;
+  double error_ppm_;
+};
+
+}  // namespace whirl::clocks
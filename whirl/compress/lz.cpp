@@ -0,0 +1,228 @@
+#include <whirl/compress/lz.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace whirl::compress::lz {
+
+static const size_t kMinMatch = 4;
+static const size_t kMaxOffset = 65535;
+// Last match starts at least this far from the end of input
+static const size_t kMatchSafeDistance = 12;
+// Trailing bytes are always literals
+static const size_t kLastLiterals = 5;
+
+// Hash table is sized to the input: small values are common
+static const size_t kMinHashBits = 8;
+static const size_t kMaxHashBits = 14;
+
+static size_t HashBits(size_t size) {
+  size_t bits = kMinHashBits;
+  while (bits < kMaxHashBits && (size_t(1) << bits) < size) {
+    ++bits;
+  }
+  return bits;
+}
+
+static uint32_t Load32(const char* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static size_t Hash(uint32_t sequence, size_t bits) {
+  return (sequence * 2654435761u) >> (32 - bits);
+}
+
+static void PutLength(std::string& output, size_t length) {
+  while (length >= 255) {
+    output.push_back(static_cast<char>(255));
+    length -= 255;
+  }
+  output.push_back(static_cast<char>(length));
+}
+
+static void PutSequence(std::string& output, const char* literals,
+                        size_t literal_length, size_t offset,
+                        size_t match_length) {
+  size_t match_code = match_length - kMinMatch;
+
+  uint8_t token = (std::min<size_t>(literal_length, 15) << 4) |
+                  std::min<size_t>(match_code, 15);
+  output.push_back(static_cast<char>(token));
+
+  if (literal_length >= 15) {
+    PutLength(output, literal_length - 15);
+  }
+  output.append(literals, literal_length);
+
+  output.push_back(static_cast<char>(offset & 0xFF));
+  output.push_back(static_cast<char>(offset >> 8));
+
+  if (match_code >= 15) {
+    PutLength(output, match_code - 15);
+  }
+}
+
+static void PutLastLiterals(std::string& output, const char* literals,
+                            size_t length) {
+  uint8_t token = std::min<size_t>(length, 15) << 4;
+  output.push_back(static_cast<char>(token));
+  if (length >= 15) {
+    PutLength(output, length - 15);
+  }
+  output.append(literals, length);
+}
+
+size_t MaxCompressedSize(size_t size) {
+  return size + size / 255 + 16;
+}
+
+void Compress(std::string_view input, std::string& output) {
+  output.reserve(output.size() + MaxCompressedSize(input.size()));
+
+  const char* begin = input.data();
+  const char* end = begin + input.size();
+  const char* anchor = begin;
+
+  if (input.size() > kMatchSafeDistance) {
+    // Positions + 1, 0 - empty
+    size_t hash_bits = HashBits(input.size());
+    std::vector<uint32_t> table(size_t(1) << hash_bits, 0);
+
+    const char* match_limit = end - kMatchSafeDistance;
+    const char* extend_limit = end - kLastLiterals;
+
+    const char* ip = begin;
+    while (ip < match_limit) {
+      uint32_t sequence = Load32(ip);
+      size_t h = Hash(sequence, hash_bits);
+      uint32_t candidate = table[h];
+      table[h] = static_cast<uint32_t>(ip - begin) + 1;
+
+      if (candidate == 0) {
+        ++ip;
+        continue;
+      }
+
+      const char* ref = begin + candidate - 1;
+      if (static_cast<size_t>(ip - ref) > kMaxOffset ||
+          Load32(ref) != sequence) {
+        ++ip;
+        continue;
+      }
+
+      // Extend backwards over pending literals
+      while (ip > anchor && ref > begin && ip[-1] == ref[-1]) {
+        --ip;
+        --ref;
+      }
+
+      const char* match_end = ip + kMinMatch;
+      const char* ref_end = ref + kMinMatch;
+      while (match_end < extend_limit && *match_end == *ref_end) {
+        ++match_end;
+        ++ref_end;
+      }
+
+      PutSequence(output, anchor, ip - anchor, ip - ref, match_end - ip);
+
+      ip = match_end;
+      anchor = ip;
+    }
+  }
+
+  PutLastLiterals(output, anchor, end - anchor);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static bool GetLength(const uint8_t*& ip, const uint8_t* end,
+                      size_t& length) {
+  uint8_t byte;
+  do {
+    if (ip == end) {
+      return false;
+    }
+    byte = *ip++;
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+size_t MaxDecompressedSize(size_t block_size) {
+  return block_size * 255 + kMinMatch;
+}
+
+std::optional<std::string> Decompress(std::string_view block, size_t size) {
+  if (size > MaxDecompressedSize(block.size())) {
+    return std::nullopt;  // Do not allocate for a corrupted size
+  }
+
+  std::string output(size, '\0');
+
+  auto* ip = reinterpret_cast<const uint8_t*>(block.data());
+  auto* in_end = ip + block.size();
+  char* op = output.data();
+  char* out_begin = op;
+  char* out_end = op + size;
+
+  while (true) {
+    if (ip == in_end) {
+      return std::nullopt;
+    }
+    uint8_t token = *ip++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !GetLength(ip, in_end, literal_length)) {
+      return std::nullopt;
+    }
+    if (literal_length > static_cast<size_t>(in_end - ip) ||
+        literal_length > static_cast<size_t>(out_end - op)) {
+      return std::nullopt;
+    }
+    std::memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip == in_end) {
+      break;  // Last sequence
+    }
+
+    if (in_end - ip < 2) {
+      return std::nullopt;
+    }
+    size_t offset = ip[0] | (size_t(ip[1]) << 8);
+    ip += 2;
+
+    size_t match_length = token & 15;
+    if (match_length == 15 && !GetLength(ip, in_end, match_length)) {
+      return std::nullopt;
+    }
+    match_length += kMinMatch;
+
+    if (offset == 0 || offset > static_cast<size_t>(op - out_begin) ||
+        match_length > static_cast<size_t>(out_end - op)) {
+      return std::nullopt;
+    }
+
+    // Byte-by-byte: source and destination may overlap
+    const char* ref = op - offset;
+    if (offset >= match_length) {
+      std::memcpy(op, ref, match_length);
+      op += match_length;
+    } else {
+      for (size_t i = 0; i < match_length; ++i) {
+        *op++ = *ref++;
+      }
+    }
+  }
+
+  if (op != out_end) {
+    return std::nullopt;
+  }
+  return output;
+}
+
+}  // namespace whirl::compress::lz
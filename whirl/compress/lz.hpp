@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace whirl::compress::lz {
+
+// Fast LZ77 block codec, LZ4-like format:
+// sequence = [token][literal length+][literals][offset: u16][match length+]
+// No entropy coding: ~GB/s decompression, 2-4x on serialized state
+
+// Worst-case size of compressed block
+size_t MaxCompressedSize(size_t size);
+
+// Appends compressed block to `output`
+void Compress(std::string_view input, std::string& output);
+
+// Upper bound on decompressed size of a well-formed block:
+// match length grows by at most 255 per input byte
+size_t MaxDecompressedSize(size_t block_size);
+
+// `size` - exact size of decompressed data, untrusted:
+// checked against MaxDecompressedSize before allocation
+// std::nullopt for malformed input
+std::optional<std::string> Decompress(std::string_view block, size_t size);
+
+}  // namespace whirl::compress::lz
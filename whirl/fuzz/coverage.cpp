@@ -0,0 +1,70 @@
+#include <whirl/fuzz/coverage.hpp>
+
+namespace whirl::fuzz {
+
+//////////////////////////////////////////////////////////////////////
+
+// Bucket hit counts: 1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+
+static uint8_t CountClass(uint8_t count) {
+  if (count == 0) {
+    return 0;
+  }
+  if (count <= 3) {
+    return 1 << (count - 1);
+  }
+  if (count <= 7) {
+    return 1 << 3;
+  }
+  if (count <= 15) {
+    return 1 << 4;
+  }
+  if (count <= 31) {
+    return 1 << 5;
+  }
+  if (count <= 127) {
+    return 1 << 6;
+  }
+  return 1 << 7;
+}
+
+size_t CoverageMap::MergeNew(const CoverageMap& run) {
+  size_t new_classes = 0;
+  for (size_t i = 0; i < kSize; ++i) {
+    uint8_t cls = CountClass(run.hits_[i]);
+    if ((hits_[i] & cls) != cls) {
+      hits_[i] |= cls;
+      ++new_classes;
+    }
+  }
+  return new_classes;
+}
+
+size_t CoverageMap::Count() const {
+  size_t count = 0;
+  for (uint8_t hits : hits_) {
+    if (hits != 0) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static thread_local CoverageMap* current_map = nullptr;
+static thread_local uint64_t prev_state = 0;
+
+void SetCoverage(CoverageMap* map) {
+  current_map = map;
+  prev_state = 0;
+}
+
+void Cover(uint64_t state) {
+  if (current_map == nullptr) {
+    return;
+  }
+  current_map->Hit((prev_state >> 1) ^ state);
+  prev_state = state;
+}
+
+}  // namespace whirl::fuzz
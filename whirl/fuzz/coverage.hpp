@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+
+namespace whirl::fuzz {
+
+// AFL-style coverage of protocol state transitions
+
+class CoverageMap {
+ public:
+  static const size_t kSize = 1 << 16;
+
+  void Hit(size_t bucket) {
+    auto& count = hits_[bucket % kSize];
+    if (count < 255) {
+      ++count;
+    }
+  }
+
+  // Merges hit count classes of `run` into this map
+  // Returns number of newly seen (bucket, class) pairs
+  size_t MergeNew(const CoverageMap& run);
+
+  // Number of buckets hit at least once
+  size_t Count() const;
+
+  void Reset() {
+    hits_.fill(0);
+  }
+
+ private:
+  // Single run: saturated hit counts
+  // Accumulated: bit mask of hit count classes
+  std::array<uint8_t, kSize> hits_{};
+};
+
+// Binds coverage map to the current thread, nullptr - disable coverage
+// Fuzzer binds fresh map for each execution
+void SetCoverage(CoverageMap* map);
+
+// Records transition from the previous covered state to `state`
+void Cover(uint64_t state);
+
+// Usage: fuzz::CoverState("raft", role, term % 4, log_size > 0);
+template <typename... Args>
+void CoverState(std::string_view label, const Args&... args) {
+  uint64_t digest = std::hash<std::string_view>{}(label);
+  ((digest = digest * 31 + std::hash<Args>{}(args)), ...);
+  Cover(digest);
+}
+
+}  // namespace whirl::fuzz
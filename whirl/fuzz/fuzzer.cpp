@@ -0,0 +1,96 @@
+#include <whirl/fuzz/fuzzer.hpp>
+
+#include <whirl/fuzz/coverage.hpp>
+#include <whirl/fuzz/minimize.hpp>
+
+namespace whirl::fuzz {
+
+//////////////////////////////////////////////////////////////////////
+
+class Fuzzer {
+ public:
+  Fuzzer(const Execution& execution, FuzzerParams params)
+      : execution_(execution),
+        params_(params),
+        mutator_(params.space, params.seed) {
+  }
+
+  FuzzReport Run() {
+    // Baseline: no faults
+    if (Try({})) {
+      return Finish();
+    }
+    for (size_t i = 0; i < params_.initial_corpus; ++i) {
+      if (Try(mutator_.Generate())) {
+        return Finish();
+      }
+    }
+
+    while (report_.executions < params_.executions) {
+      const Schedule& parent = corpus_[mutator_.Pick(corpus_.size())];
+      const Schedule& donor = corpus_[mutator_.Pick(corpus_.size())];
+      if (Try(mutator_.Mutate(parent, &donor))) {
+        break;
+      }
+    }
+
+    return Finish();
+  }
+
+ private:
+  // Returns true if failure is found
+  bool Try(Schedule schedule) {
+    CoverageMap run;
+    Outcome outcome = Execute(schedule, &run);
+
+    if (outcome.failure.has_value()) {
+      report_.failure = std::move(*outcome.failure);
+      report_.failing = params_.minimize ? Minimize(std::move(schedule))
+                                         : std::move(schedule);
+      return true;
+    }
+
+    if (total_.MergeNew(run) > 0 || corpus_.empty()) {
+      corpus_.push_back(std::move(schedule));
+    }
+    return false;
+  }
+
+  Outcome Execute(const Schedule& schedule, CoverageMap* coverage) {
+    ++report_.executions;
+    SetCoverage(coverage);
+    Outcome outcome = execution_(schedule);
+    SetCoverage(nullptr);
+    return outcome;
+  }
+
+  Schedule Minimize(Schedule failing) {
+    return fuzz::Minimize(std::move(failing), [this](const Schedule& s) {
+      return Execute(s, nullptr).failure.has_value();
+    });
+  }
+
+  FuzzReport Finish() {
+    report_.corpus_size = corpus_.size();
+    report_.coverage = total_.Count();
+    return std::move(report_);
+  }
+
+ private:
+  const Execution& execution_;
+  const FuzzerParams params_;
+
+  Mutator mutator_;
+  std::vector<Schedule> corpus_;
+  CoverageMap total_;
+
+  FuzzReport report_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+FuzzReport RunFuzzer(const Execution& execution, FuzzerParams params) {
+  return Fuzzer{execution, params}.Run();
+}
+
+}  // namespace whirl::fuzz
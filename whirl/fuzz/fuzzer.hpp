@@ -0,0 +1,44 @@
+#pragma once
+
+#include <whirl/fuzz/schedule.hpp>
+#include <whirl/fuzz/mutator.hpp>
+
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace whirl::fuzz {
+
+struct Outcome {
+  // std::nullopt - simulation succeeded
+  std::optional<std::string> failure;
+};
+
+// Runs deterministic simulation (fixed seed) injecting faults from `schedule`
+// Protocol state coverage is collected via fuzz::Cover / CoverState
+using Execution = std::function<Outcome(const Schedule& schedule)>;
+
+struct FuzzerParams {
+  ScheduleSpace space;
+  size_t executions = 10000;
+  uint64_t seed = 42;
+  // Random schedules in the initial corpus
+  size_t initial_corpus = 16;
+  bool minimize = true;
+};
+
+struct FuzzReport {
+  size_t executions = 0;
+  size_t corpus_size = 0;
+  // Covered buckets
+  size_t coverage = 0;
+
+  // Minimized failing schedule
+  std::optional<Schedule> failing;
+  std::string failure;
+};
+
+// Coverage-guided search for a failing fault schedule
+FuzzReport RunFuzzer(const Execution& execution, FuzzerParams params);
+
+}  // namespace whirl::fuzz
@@ -0,0 +1,71 @@
+#include <whirl/fuzz/minimize.hpp>
+
+#include <algorithm>
+
+namespace whirl::fuzz {
+
+static Schedule WithoutChunk(const Schedule& schedule, size_t begin,
+                             size_t end) {
+  Schedule complement;
+  complement.insert(complement.end(), schedule.begin(),
+                    schedule.begin() + begin);
+  complement.insert(complement.end(), schedule.begin() + end,
+                    schedule.end());
+  return complement;
+}
+
+static Schedule RemoveFaults(Schedule schedule, const FailurePredicate& fails) {
+  size_t granularity = 2;
+
+  while (schedule.size() >= 2) {
+    size_t chunk = (schedule.size() + granularity - 1) / granularity;
+    bool reduced = false;
+
+    for (size_t begin = 0; begin < schedule.size(); begin += chunk) {
+      size_t end = std::min(begin + chunk, schedule.size());
+      Schedule complement = WithoutChunk(schedule, begin, end);
+      if (fails(complement)) {
+        schedule = std::move(complement);
+        granularity = std::max<size_t>(granularity - 1, 2);
+        reduced = true;
+        break;
+      }
+    }
+
+    if (!reduced) {
+      if (granularity >= schedule.size()) {
+        break;
+      }
+      granularity = std::min(granularity * 2, schedule.size());
+    }
+  }
+
+  // Single remaining fault may be unnecessary too
+  if (schedule.size() == 1 && fails({})) {
+    schedule.clear();
+  }
+
+  return schedule;
+}
+
+// Halve durations / delays / offsets while failure reproduces
+static void ShrinkArgs(Schedule& schedule, const FailurePredicate& fails) {
+  for (auto& fault : schedule) {
+    while (fault.arg / 2 != 0) {
+      int64_t prev = fault.arg;
+      fault.arg /= 2;
+      if (!fails(schedule)) {
+        fault.arg = prev;
+        break;
+      }
+    }
+  }
+}
+
+Schedule Minimize(Schedule failing, const FailurePredicate& fails) {
+  Schedule minimal = RemoveFaults(std::move(failing), fails);
+  ShrinkArgs(minimal, fails);
+  return minimal;
+}
+
+}  // namespace whirl::fuzz
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <whirl/fuzz/schedule.hpp>
+
+#include <functional>
+
+namespace whirl::fuzz {
+
+// Returns true if simulation still fails with this schedule
+using FailurePredicate = std::function<bool(const Schedule& schedule)>;
+
+// Delta debugging (ddmin) over faults followed by argument shrinking
+// Result is 1-minimal: removing any single fault makes the failure disappear
+// Scott et al., Minimizing Faulty Executions of Distributed Systems
+Schedule Minimize(Schedule failing, const FailurePredicate& fails);
+
+}  // namespace whirl::fuzz
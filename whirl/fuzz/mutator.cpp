@@ -0,0 +1,94 @@
+#include <whirl/fuzz/mutator.hpp>
+
+#include <algorithm>
+
+namespace whirl::fuzz {
+
+static const size_t kFaultTypes = 5;
+
+Jiffies Mutator::RandomTime() {
+  return Uniform(0, space_.horizon.Count() - 1);
+}
+
+int64_t Mutator::RandomArg(Fault::Type type) {
+  auto arg = static_cast<int64_t>(Uniform(1, space_.max_arg));
+  if (type == Fault::Type::SkewWallClock && Uniform(0, 1) == 0) {
+    return -arg;
+  }
+  return arg;
+}
+
+Fault Mutator::RandomFault() {
+  auto type = static_cast<Fault::Type>(Uniform(0, kFaultTypes - 1));
+  return {type, Pick(space_.nodes), RandomTime(), RandomArg(type)};
+}
+
+Schedule Mutator::Generate() {
+  Schedule schedule;
+  size_t count = Uniform(1, space_.max_faults);
+  for (size_t i = 0; i < count; ++i) {
+    schedule.push_back(RandomFault());
+  }
+  Sort(schedule);
+  return schedule;
+}
+
+Schedule Mutator::Mutate(const Schedule& schedule, const Schedule* donor) {
+  Schedule mutant = schedule;
+  // Stacked mutations, AFL havoc-style
+  size_t rounds = 1 << Uniform(0, 3);
+  for (size_t i = 0; i < rounds; ++i) {
+    MutateOnce(mutant, donor);
+  }
+  Sort(mutant);
+  return mutant;
+}
+
+void Mutator::MutateOnce(Schedule& schedule, const Schedule* donor) {
+  if (schedule.empty()) {
+    schedule.push_back(RandomFault());
+    return;
+  }
+
+  Fault& fault = schedule[Pick(schedule.size())];
+
+  switch (Uniform(0, 6)) {
+    case 0:
+      if (schedule.size() < space_.max_faults) {
+        schedule.push_back(RandomFault());
+      }
+      break;
+    case 1:
+      schedule.erase(schedule.begin() + Pick(schedule.size()));
+      break;
+    case 2:
+      // Small shift in time
+      {
+        uint64_t shift = Uniform(0, space_.horizon.Count() / 16 + 1);
+        uint64_t at = fault.at.Count();
+        at = Uniform(0, 1) == 0 ? at + shift : (at > shift ? at - shift : 0);
+        fault.at = std::min(at, space_.horizon.Count() - 1);
+      }
+      break;
+    case 3:
+      fault.at = RandomTime();
+      break;
+    case 4:
+      fault.node = Pick(space_.nodes);
+      break;
+    case 5:
+      fault.arg = RandomArg(fault.type);
+      break;
+    case 6:
+      // Splice: take a fault from another corpus entry
+      if (donor != nullptr && !donor->empty() &&
+          schedule.size() < space_.max_faults) {
+        schedule.push_back((*donor)[Pick(donor->size())]);
+      } else {
+        fault = RandomFault();
+      }
+      break;
+  }
+}
+
+}  // namespace whirl::fuzz
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <whirl/fuzz/schedule.hpp>
+
+#include <random>
+
+namespace whirl::fuzz {
+
+struct ScheduleSpace {
+  size_t nodes = 3;
+  // Faults are injected at [0, horizon)
+  Jiffies horizon = 10000;
+  size_t max_faults = 16;
+  // Upper bound for durations / delays / clock offsets
+  uint64_t max_arg = 1000;
+};
+
+// Deterministic random generation and mutation of fault schedules
+
+class Mutator {
+ public:
+  Mutator(ScheduleSpace space, uint64_t seed) : space_(space), random_(seed) {
+  }
+
+  Fault RandomFault();
+
+  Schedule Generate();
+
+  // `donor` - another corpus entry for splicing, may be nullptr
+  Schedule Mutate(const Schedule& schedule, const Schedule* donor);
+
+  size_t Pick(size_t size) {
+    return std::uniform_int_distribution<size_t>(0, size - 1)(random_);
+  }
+
+ private:
+  uint64_t Uniform(uint64_t lo, uint64_t hi) {
+    return std::uniform_int_distribution<uint64_t>(lo, hi)(random_);
+  }
+
+  int64_t RandomArg(Fault::Type type);
+  Jiffies RandomTime();
+
+  void MutateOnce(Schedule& schedule, const Schedule* donor);
+
+ private:
+  const ScheduleSpace space_;
+  std::mt19937_64 random_;
+};
+
+}  // namespace whirl::fuzz
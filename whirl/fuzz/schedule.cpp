@@ -0,0 +1,66 @@
+#include <whirl/fuzz/schedule.hpp>
+
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+
+namespace whirl::fuzz {
+
+static const char* TypeName(Fault::Type type) {
+  switch (type) {
+    case Fault::Type::ThreadPause: return "ThreadPause";
+    case Fault::Type::Reboot: return "Reboot";
+    case Fault::Type::DropMessages: return "DropMessages";
+    case Fault::Type::DelayMessages: return "DelayMessages";
+    case Fault::Type::SkewWallClock: return "SkewWallClock";
+  }
+  return "?";
+}
+
+std::string Fault::ToString() const {
+  return fmt::format("{}(node = {}, arg = {}) at {}", TypeName(type), node,
+                     arg, at.Count());
+}
+
+void Sort(Schedule& schedule) {
+  std::stable_sort(schedule.begin(), schedule.end(),
+                   [](const Fault& lhs, const Fault& rhs) {
+                     return lhs.at < rhs.at;
+                   });
+}
+
+std::string ToString(const Schedule& schedule) {
+  std::string repr;
+  for (const auto& fault : schedule) {
+    repr += fault.ToString();
+    repr += '\n';
+  }
+  return repr;
+}
+
+void Inject(const Fault& fault, IFaultInjector* injector) {
+  switch (fault.type) {
+    case Fault::Type::ThreadPause:
+      injector->ThreadPause();
+      break;
+    case Fault::Type::Reboot:
+      injector->Reboot();
+      break;
+    case Fault::Type::DropMessages:
+      injector->DropMessages(static_cast<uint64_t>(fault.arg));
+      break;
+    case Fault::Type::DelayMessages:
+      injector->DelayMessages(static_cast<uint64_t>(fault.arg),
+                              static_cast<uint64_t>(fault.arg) * 2);
+      break;
+    case Fault::Type::SkewWallClock:
+      injector->SkewWallClock(fault.arg);
+      break;
+    default:
+      WHEELS_PANIC("Unknown fault type");
+  }
+}
+
+}  // namespace whirl::fuzz
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <whirl/node/misc/fault.hpp>
+
+#include <string>
+#include <vector>
+
+namespace whirl::fuzz {
+
+// Fault schedule: what, where and when to inject
+
+struct Fault {
+  enum class Type {
+    ThreadPause,
+    Reboot,
+    DropMessages,    // arg = duration
+    DelayMessages,   // arg = delay, duration = 2 * delay
+    SkewWallClock,   // arg = offset
+  };
+
+  Type type;
+  // Index of target node
+  size_t node;
+  // Simulated time of injection
+  Jiffies at;
+  int64_t arg = 0;
+
+  std::string ToString() const;
+};
+
+// Sorted by `at`
+using Schedule = std::vector<Fault>;
+
+void Sort(Schedule& schedule);
+
+std::string ToString(const Schedule& schedule);
+
+// Engine calls this when simulated time reaches `fault.at`
+void Inject(const Fault& fault, IFaultInjector* injector);
+
+}  // namespace whirl::fuzz
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+#include <whirl/node/time/wall_time.hpp>
+#include <whirl/node/time/monotonic_time.hpp>
+
+#include <commute/rpc/channel.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace whirl::history {
+
+struct TimeStamp {
+  // Single clock shared by all nodes (see Recorder::GlobalClock),
+  // the only one comparable across nodes
+  Jiffies global;
+  // Clocks of the calling node, for diagnostics
+  node::time::WallTime wall;
+  node::time::MonotonicTime monotonic;
+};
+
+// Client RPC call observed by the recorder
+
+struct Call {
+  commute::rpc::Method method;
+  commute::rpc::Message input;
+
+  TimeStamp invoke;
+  // std::nullopt - call is still in progress or failed:
+  // effect of failed call is unknown, so it is treated as never completed
+  std::optional<TimeStamp> complete;
+
+  std::optional<commute::rpc::Message> output;
+
+  bool IsCompleted() const {
+    return complete.has_value();
+  }
+};
+
+using History = std::vector<Call>;
+
+}  // namespace whirl::history
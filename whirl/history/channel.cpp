@@ -0,0 +1,62 @@
+#include <whirl/history/channel.hpp>
+
+#include <await/futures/core/future.hpp>
+
+using await::futures::Future;
+
+using commute::rpc::CallOptions;
+using commute::rpc::IChannel;
+using commute::rpc::IChannelPtr;
+using commute::rpc::Message;
+using commute::rpc::Method;
+
+namespace whirl::history {
+
+//////////////////////////////////////////////////////////////////////
+
+class RecordingChannel : public IChannel {
+ public:
+  RecordingChannel(IChannelPtr channel, Recorder* recorder)
+      : channel_(std::move(channel)), recorder_(recorder) {
+  }
+
+  Future<Message> Call(const Method& method, const Message& input,
+                       CallOptions options) override {
+    auto id = recorder_->Invoke(method, input);
+
+    auto [future, promise] = await::futures::MakeContract<Message>();
+
+    channel_->Call(method, input, std::move(options))
+        .Subscribe([recorder = recorder_, id, promise = std::move(promise)](
+                       wheels::Result<Message> result) mutable {
+          if (result.IsOk()) {
+            recorder->Complete(id, *result);
+          } else {
+            recorder->Complete(id, std::nullopt);
+          }
+          std::move(promise).Set(std::move(result));
+        });
+
+    return std::move(future);
+  }
+
+  const std::string& Peer() const override {
+    return channel_->Peer();
+  }
+
+  void Close() override {
+    channel_->Close();
+  }
+
+ private:
+  IChannelPtr channel_;
+  Recorder* recorder_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+IChannelPtr MakeRecordingChannel(IChannelPtr channel, Recorder* recorder) {
+  return std::make_shared<RecordingChannel>(std::move(channel), recorder);
+}
+
+}  // namespace whirl::history
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <whirl/history/recorder.hpp>
+
+#include <commute/rpc/channel.hpp>
+
+namespace whirl::history {
+
+// Records every call made through `channel`
+commute::rpc::IChannelPtr MakeRecordingChannel(commute::rpc::IChannelPtr channel,
+                                               Recorder* recorder);
+
+}  // namespace whirl::history
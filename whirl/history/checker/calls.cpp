@@ -0,0 +1,38 @@
+#include <whirl/history/checker/calls.hpp>
+
+namespace whirl::history::kv {
+
+static Time ToTime(const TimeStamp& stamp) {
+  return stamp.global.Count();
+}
+
+History DecodeCalls(const history::History& calls,
+                    const CallDecoder& decode) {
+  History ops;
+  ops.reserve(calls.size());
+
+  for (const auto& call : calls) {
+    auto command = decode(call);
+    if (!command.has_value()) {
+      continue;
+    }
+
+    Operation op{command->type, std::move(command->key),
+                 std::move(command->value), ToTime(call.invoke),
+                 std::nullopt};
+    if (call.IsCompleted()) {
+      op.end = ToTime(*call.complete);
+    }
+    ops.push_back(std::move(op));
+  }
+
+  return ops;
+}
+
+CheckResult CheckLinearizability(const history::History& calls,
+                                 const CallDecoder& decode,
+                                 CheckerParams params) {
+  return CheckLinearizability(DecodeCalls(calls, decode), params);
+}
+
+}  // namespace whirl::history::kv
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <whirl/history/call.hpp>
+#include <whirl/history/checker/kv.hpp>
+
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace whirl::history::kv {
+
+// Adapter from recorded client calls (history::Recorder) to KV operations
+
+// KV operation encoded in a single call, without time stamps
+struct Command {
+  Operation::Type type;
+  std::string key;
+  // Write: decoded from call input
+  // Read: decoded from call output, ignored for incomplete reads
+  std::optional<std::string> value;
+};
+
+// Knows the wire format of the service under test, e.g.
+//
+// [](const Call& call) -> std::optional<kv::Command> {
+//   if (IsSet(call.method)) {
+//     auto [key, value] = muesli::Deserialize<SetRequest>(call.input);
+//     return kv::Command{Operation::Type::Write, key, value};
+//   }
+//   ...
+// }
+//
+// std::nullopt - call is not a KV operation and is skipped
+using CallDecoder = std::function<std::optional<Command>(const Call& call)>;
+
+// Operations are stamped with global time of invoke / complete
+History DecodeCalls(const history::History& calls, const CallDecoder& decode);
+
+CheckResult CheckLinearizability(const history::History& calls,
+                                 const CallDecoder& decode,
+                                 CheckerParams params = {});
+
+}  // namespace whirl::history::kv
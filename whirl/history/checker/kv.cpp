@@ -0,0 +1,117 @@
+#include <whirl/history/checker/kv.hpp>
+#include <whirl/history/checker/register.hpp>
+
+#include <fmt/core.h>
+
+#include <map>
+#include <unordered_map>
+
+namespace whirl::history::kv {
+
+using detail::RegisterHistory;
+using detail::RegisterOp;
+using detail::ValueId;
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+class RegisterBuilder {
+ public:
+  void Add(const Operation& op) {
+    if (op.type == Operation::Type::Read && !op.end.has_value()) {
+      return;  // Incomplete reads do not constrain anything
+    }
+
+    bool write = op.type == Operation::Type::Write;
+    ValueId value = Intern(op.value);
+
+    if (write && ++writes_[value] > 1) {
+      unique_writes_ = false;
+    }
+
+    history_.ops.push_back({write, value, Shift(op.start), ShiftEnd(op.end)});
+  }
+
+  bool UniqueWrites() const {
+    return unique_writes_;
+  }
+
+  const RegisterHistory& History() const {
+    return history_;
+  }
+
+ private:
+  ValueId Intern(const std::optional<std::string>& value) {
+    if (!value.has_value()) {
+      return detail::kAbsent;
+    }
+    auto [it, inserted] = values_.try_emplace(*value, history_.value_count);
+    if (inserted) {
+      ++history_.value_count;
+    }
+    return it->second;
+  }
+
+  // Time 0 is reserved for the initial write
+  static Time Shift(Time t) {
+    return std::min(t, detail::kInfinity - 2) + 1;
+  }
+
+  static Time ShiftEnd(std::optional<Time> t) {
+    return t.has_value() ? Shift(*t) : detail::kInfinity;
+  }
+
+ private:
+  RegisterHistory history_;
+  std::unordered_map<std::string, ValueId> values_;
+  // Initial value counts as written once
+  std::unordered_map<ValueId, size_t> writes_{{detail::kAbsent, 1}};
+  bool unique_writes_ = true;
+};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+CheckResult CheckLinearizability(const History& history,
+                                 CheckerParams params) {
+  // Ordered for deterministic reports
+  std::map<std::string, RegisterBuilder> registers;
+
+  for (const auto& op : history) {
+    registers[op.key].Add(op);
+  }
+
+  std::optional<CheckResult> unknown;
+
+  for (const auto& [key, reg] : registers) {
+    std::optional<std::string> violation;
+
+    if (reg.UniqueWrites()) {
+      violation = detail::CheckZones(reg.History());
+    } else if (reg.History().ops.size() <= params.max_search_ops) {
+      violation = detail::CheckSearch(reg.History());
+    } else {
+      if (!unknown.has_value()) {
+        unknown = CheckResult{
+            Verdict::Unknown, key,
+            fmt::format("Duplicate writes and {} operations: search limit "
+                        "exceeded",
+                        reg.History().ops.size())};
+      }
+      continue;
+    }
+
+    if (violation.has_value()) {
+      return {Verdict::NotLinearizable, key, std::move(*violation)};
+    }
+  }
+
+  if (unknown.has_value()) {
+    return std::move(*unknown);
+  }
+  return {Verdict::Linearizable, "", ""};
+}
+
+}  // namespace whirl::history::kv
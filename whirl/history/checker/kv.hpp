@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace whirl::history::kv {
+
+// Linearizability checker for key-value histories
+// Each key is checked as an independent read/write register (locality)
+
+// Any clock shared by all clients, e.g. engine (simulator) time
+using Time = uint64_t;
+
+struct Operation {
+  enum class Type { Read, Write };
+
+  Type type;
+  std::string key;
+  // Write: written value, std::nullopt - delete
+  // Read: observed value, std::nullopt - key is absent
+  std::optional<std::string> value;
+
+  Time start;
+  // std::nullopt - operation is incomplete (pending or failed)
+  std::optional<Time> end;
+};
+
+using History = std::vector<Operation>;
+
+enum class Verdict {
+  Linearizable,
+  NotLinearizable,
+  Unknown  // Search limit exceeded
+};
+
+struct CheckResult {
+  Verdict verdict;
+  // First register that is not linearizable / was not checked
+  std::string key;
+  std::string explanation;
+
+  bool Ok() const {
+    return verdict == Verdict::Linearizable;
+  }
+};
+
+struct CheckerParams {
+  // Registers with unique written values are checked in O(n log n),
+  // others fall back to exhaustive WGL search limited by this number of ops
+  size_t max_search_ops = 64;
+};
+
+CheckResult CheckLinearizability(const History& history,
+                                 CheckerParams params = {});
+
+}  // namespace whirl::history::kv
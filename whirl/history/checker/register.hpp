@@ -0,0 +1,44 @@
+#pragma once
+
+#include <whirl/history/checker/kv.hpp>
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace whirl::history::kv::detail {
+
+// Single register history with interned values
+
+// Value id, kAbsent - initial value
+using ValueId = size_t;
+static const ValueId kAbsent = 0;
+
+// Shifted by one: Time 0 is reserved for the initial write
+static const Time kInfinity = std::numeric_limits<Time>::max();
+
+struct RegisterOp {
+  bool write;
+  ValueId value;
+  Time start;
+  Time end;  // kInfinity - incomplete
+};
+
+struct RegisterHistory {
+  std::vector<RegisterOp> ops;
+  size_t value_count = 1;  // Including kAbsent
+};
+
+// Empty - linearizable, explanation of violation otherwise
+
+// O(n log n), requires unique written values
+// Gibbons & Korach, Testing shared memories
+// http://rystsov.info/2017/07/16/linearizability-testing.html
+std::optional<std::string> CheckZones(const RegisterHistory& history);
+
+// Exhaustive search with memoization, exponential in the worst case
+// Wing & Gong, Lowe: Testing for linearizability
+std::optional<std::string> CheckSearch(const RegisterHistory& history);
+
+}  // namespace whirl::history::kv::detail
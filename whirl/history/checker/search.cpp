@@ -0,0 +1,216 @@
+#include <whirl/history/checker/register.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace whirl::history::kv::detail {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct Event {
+  bool call;
+  size_t op;
+  Time time;
+  size_t match = 0;  // Call -> return
+};
+
+// Set of linearized operations + register state
+struct Configuration {
+  std::vector<uint64_t> linearized;
+  ValueId state;
+
+  bool operator==(const Configuration& that) const {
+    return state == that.state && linearized == that.linearized;
+  }
+};
+
+struct ConfigurationHasher {
+  size_t operator()(const Configuration& config) const {
+    size_t digest = std::hash<ValueId>{}(config.state);
+    for (uint64_t word : config.linearized) {
+      digest ^= std::hash<uint64_t>{}(word) + 0x9e3779b97f4a7c15 +
+                (digest << 6) + (digest >> 2);
+    }
+    return digest;
+  }
+};
+
+// Doubly-linked list of events with O(1) lift / unlift
+class EventList {
+ public:
+  explicit EventList(std::vector<Event> events)
+      : events_(std::move(events)),
+        next_(events_.size() + 2),
+        prev_(events_.size() + 2) {
+    // Entry i + 1 <-> events_[i], 0 - head, size + 1 - tail
+    for (size_t i = 0; i + 1 < next_.size(); ++i) {
+      next_[i] = i + 1;
+      prev_[i + 1] = i;
+    }
+  }
+
+  size_t First() const {
+    return next_[kHead];
+  }
+
+  size_t Next(size_t entry) const {
+    return next_[entry];
+  }
+
+  bool IsTail(size_t entry) const {
+    return entry == next_.size() - 1;
+  }
+
+  const Event& Get(size_t entry) const {
+    return events_[entry - 1];
+  }
+
+  // Removes call entry and its matching return
+  void Lift(size_t call) {
+    Remove(call);
+    Remove(Get(call).match + 1);
+  }
+
+  // Reverses the last Lift
+  void Unlift(size_t call) {
+    Restore(Get(call).match + 1);
+    Restore(call);
+  }
+
+ private:
+  void Remove(size_t entry) {
+    next_[prev_[entry]] = next_[entry];
+    prev_[next_[entry]] = prev_[entry];
+  }
+
+  void Restore(size_t entry) {
+    next_[prev_[entry]] = entry;
+    prev_[next_[entry]] = entry;
+  }
+
+ private:
+  static const size_t kHead = 0;
+
+  std::vector<Event> events_;
+  std::vector<size_t> next_;
+  std::vector<size_t> prev_;
+};
+
+EventList MakeEventList(const RegisterHistory& history) {
+  std::vector<Event> events;
+  for (size_t i = 0; i < history.ops.size(); ++i) {
+    events.push_back({true, i, history.ops[i].start});
+    events.push_back({false, i, history.ops[i].end});
+  }
+
+  // Operations that end and start at the same time are concurrent,
+  // so calls go before returns
+  std::stable_sort(events.begin(), events.end(),
+                   [](const Event& lhs, const Event& rhs) {
+                     if (lhs.time != rhs.time) {
+                       return lhs.time < rhs.time;
+                     }
+                     return lhs.call && !rhs.call;
+                   });
+
+  std::vector<size_t> returns(history.ops.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (!events[i].call) {
+      returns[events[i].op] = i;
+    }
+  }
+  for (auto& event : events) {
+    if (event.call) {
+      event.match = returns[event.op];
+    }
+  }
+
+  return EventList{std::move(events)};
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+std::optional<std::string> CheckSearch(const RegisterHistory& history) {
+  const auto& ops = history.ops;
+
+  size_t complete_count = 0;
+  for (const auto& op : ops) {
+    if (op.end != kInfinity) {
+      ++complete_count;
+    }
+  }
+
+  EventList list = MakeEventList(history);
+
+  Configuration config{std::vector<uint64_t>((ops.size() + 63) / 64), kAbsent};
+  std::unordered_set<Configuration, ConfigurationHasher> visited;
+
+  struct Frame {
+    size_t entry;
+    ValueId state;
+  };
+  std::vector<Frame> stack;
+
+  size_t linearized_complete = 0;
+  size_t entry = list.First();
+
+  while (linearized_complete < complete_count) {
+    if (list.IsTail(entry)) {
+      break;  // Unreachable: returns of incomplete ops are the last ones
+    }
+
+    const Event& event = list.Get(entry);
+    const RegisterOp& op = ops[event.op];
+
+    if (event.call) {
+      // Try to linearize `op` at this point
+      bool legal = op.write || op.value == config.state;
+      ValueId next_state = op.write ? op.value : config.state;
+
+      if (legal) {
+        Configuration next = config;
+        next.linearized[event.op / 64] |= uint64_t{1} << (event.op % 64);
+        next.state = next_state;
+
+        if (visited.insert(next).second) {
+          stack.push_back({entry, config.state});
+          config = std::move(next);
+          if (op.end != kInfinity) {
+            ++linearized_complete;
+          }
+          list.Lift(entry);
+          entry = list.First();
+          continue;
+        }
+      }
+      entry = list.Next(entry);
+    } else {
+      if (op.end == kInfinity) {
+        break;  // Only incomplete operations left
+      }
+      // Pending operation must be linearized before its return: backtrack
+      if (stack.empty()) {
+        return "No valid linearization";
+      }
+      Frame frame = stack.back();
+      stack.pop_back();
+
+      size_t undo_op = list.Get(frame.entry).op;
+      config.linearized[undo_op / 64] &= ~(uint64_t{1} << (undo_op % 64));
+      config.state = frame.state;
+      if (ops[undo_op].end != kInfinity) {
+        --linearized_complete;
+      }
+      list.Unlift(frame.entry);
+      entry = list.Next(frame.entry);
+    }
+  }
+
+  return std::nullopt;
+}
+
+}  // namespace whirl::history::kv::detail
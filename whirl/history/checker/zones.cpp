@@ -0,0 +1,108 @@
+#include <whirl/history/checker/register.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+
+namespace whirl::history::kv::detail {
+
+// Cluster: write of some value + all reads observing it
+struct Cluster {
+  bool has_write = false;
+  Time write_start = 0;
+
+  Time min_end = kInfinity;
+  Time max_start = 0;
+};
+
+// Closed interval [low, high]
+struct Zone {
+  Time low;
+  Time high;
+};
+
+std::optional<std::string> CheckZones(const RegisterHistory& history) {
+  std::vector<Cluster> clusters(history.value_count);
+
+  // Initial write precedes everything
+  clusters[kAbsent].has_write = true;
+  clusters[kAbsent].min_end = 0;
+
+  for (const auto& op : history.ops) {
+    auto& cluster = clusters[op.value];
+    if (op.write) {
+      cluster.has_write = true;
+      cluster.write_start = op.start;
+    }
+    cluster.min_end = std::min(cluster.min_end, op.end);
+    cluster.max_start = std::max(cluster.max_start, op.start);
+  }
+
+  for (const auto& op : history.ops) {
+    if (op.write) {
+      continue;
+    }
+    const auto& cluster = clusters[op.value];
+    if (!cluster.has_write) {
+      return "Read returned value that was never written";
+    }
+    if (op.end < cluster.write_start) {
+      return fmt::format("Read completed at {} before its write started at {}",
+                         op.end, cluster.write_start);
+    }
+  }
+
+  std::vector<Zone> forward;
+  std::vector<Zone> backward;
+
+  for (const auto& cluster : clusters) {
+    if (!cluster.has_write) {
+      continue;  // Value is not used in this register
+    }
+    if (cluster.min_end < cluster.max_start) {
+      forward.push_back({cluster.min_end, cluster.max_start});
+    } else {
+      backward.push_back({cluster.max_start, cluster.min_end});
+    }
+  }
+
+  std::sort(forward.begin(), forward.end(), [](const Zone& lhs, const Zone& rhs) {
+    return lhs.low < rhs.low;
+  });
+
+  // 1) Forward zones do not overlap
+  // It is enough to check neighbours after sorting
+
+  for (size_t i = 1; i < forward.size(); ++i) {
+    if (forward[i].low < forward[i - 1].high) {
+      return fmt::format("Forward zones [{}, {}] and [{}, {}] overlap",
+                         forward[i - 1].low, forward[i - 1].high,
+                         forward[i].low, forward[i].high);
+    }
+  }
+
+  // 2) Backward zone is not contained in a forward zone
+  // Forward zones are disjoint, so the only candidate is
+  // the last one starting before the backward zone
+
+  for (const auto& zone : backward) {
+    auto it = std::lower_bound(
+        forward.begin(), forward.end(), zone.low,
+        [](const Zone& f, Time t) {
+          return f.low < t;
+        });
+    if (it == forward.begin()) {
+      continue;
+    }
+    --it;
+    if (zone.high < it->high) {
+      return fmt::format(
+          "Backward zone [{}, {}] is contained in forward zone [{}, {}]",
+          zone.low, zone.high, it->low, it->high);
+    }
+  }
+
+  return std::nullopt;
+}
+
+}  // namespace whirl::history::kv::detail
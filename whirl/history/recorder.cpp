@@ -0,0 +1,45 @@
+#include <whirl/history/recorder.hpp>
+
+#include <whirl/node/runtime/shortcuts.hpp>
+
+#include <wheels/support/assert.hpp>
+
+namespace whirl::history {
+
+TimeStamp Recorder::Now() const {
+  return {clock_(), node::rt::WallTimeNow(), node::rt::MonotonicNow()};
+}
+
+Recorder::CallId Recorder::Invoke(const commute::rpc::Method& method,
+                                  const commute::rpc::Message& input) {
+  auto now = Now();
+
+  std::lock_guard guard(mutex_);
+  calls_.push_back({method, input, now, std::nullopt, std::nullopt});
+  return calls_.size() - 1;
+}
+
+void Recorder::Complete(CallId id,
+                        std::optional<commute::rpc::Message> output) {
+  auto now = Now();
+
+  std::lock_guard guard(mutex_);
+  WHEELS_VERIFY(id < calls_.size(), "Unknown call");
+
+  auto& call = calls_[id];
+  WHEELS_VERIFY(!call.IsCompleted(), "Call already completed");
+
+  // Failed call may still take effect, so it stays concurrent
+  // with everything after its invocation
+  if (output.has_value()) {
+    call.complete = now;
+    call.output = std::move(output);
+  }
+}
+
+History Recorder::GetHistory() const {
+  std::lock_guard guard(mutex_);
+  return calls_;
+}
+
+}  // namespace whirl::history
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <whirl/history/call.hpp>
+
+#include <functional>
+#include <mutex>
+
+namespace whirl::history {
+
+// Records invoke / complete events of client calls
+// Calls are ordered by the global clock: node clocks drift and
+// monotonic time restarts on reboot, so they are not comparable
+// across nodes
+
+class Recorder {
+ public:
+  using CallId = size_t;
+
+  // Engine time, e.g. simulator time or real monotonic time of the process
+  using GlobalClock = std::function<Jiffies()>;
+
+  explicit Recorder(GlobalClock clock) : clock_(std::move(clock)) {
+  }
+
+  CallId Invoke(const commute::rpc::Method& method,
+                const commute::rpc::Message& input);
+
+  // `output` == std::nullopt - call failed, its effect is unknown
+  void Complete(CallId id, std::optional<commute::rpc::Message> output);
+
+  History GetHistory() const;
+
+ private:
+  TimeStamp Now() const;
+
+ private:
+  const GlobalClock clock_;
+  mutable std::mutex mutex_;
+  History calls_;
+};
+
+}  // namespace whirl::history
@@ -0,0 +1,233 @@
+#include <whirl/logging/async_backend.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+
+namespace whirl::logging {
+
+//////////////////////////////////////////////////////////////////////
+
+// Bounded single-producer / single-consumer queue
+
+class AsyncLogBackend::Ring {
+ public:
+  explicit Ring(size_t capacity) : slots_(capacity), mask_(capacity - 1) {
+  }
+
+  // Producer
+  bool TryPush(timber::Event&& event) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_acquire);
+    if (tail - head == slots_.size()) {
+      return false;
+    }
+    slots_[tail & mask_].emplace(std::move(event));
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer
+  template <typename F>
+  size_t Drain(F&& consume) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+
+    for (size_t i = head; i < tail; ++i) {
+      auto& slot = slots_[i & mask_];
+      consume(std::move(*slot));
+      slot.reset();
+    }
+    head_.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+  size_t Head() const {
+    return head_.load(std::memory_order_acquire);
+  }
+
+  size_t Tail() const {
+    return tail_.load(std::memory_order_acquire);
+  }
+
+  // Ownership by producer thread
+  // Release / acquire hands the producer side over to the next owner
+
+  bool TryAcquire() {
+    bool expected = false;
+    return owned_.compare_exchange_strong(expected, true,
+                                          std::memory_order_acquire);
+  }
+
+  void Release() {
+    owned_.store(false, std::memory_order_release);
+  }
+
+  // Backend is destroyed, ring is not drained anymore
+  void Close() {
+    closed_.store(true, std::memory_order_release);
+  }
+
+  bool IsClosed() const {
+    return closed_.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::vector<std::optional<timber::Event>> slots_;
+  const size_t mask_;
+
+  // Separate cache lines for producer and consumer
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+
+  std::atomic<bool> owned_{false};
+  std::atomic<bool> closed_{false};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Rings of the current thread, one per backend
+// Released on thread exit, so backends can hand them to new threads
+
+class AsyncLogBackend::ThreadRings {
+ public:
+  ~ThreadRings() {
+    for (auto& entry : entries_) {
+      entry.ring->Release();
+    }
+  }
+
+  Ring* Find(uint64_t backend_id) const {
+    for (const auto& entry : entries_) {
+      if (entry.backend_id == backend_id) {
+        return entry.ring.get();
+      }
+    }
+    return nullptr;
+  }
+
+  void Add(uint64_t backend_id, std::shared_ptr<Ring> ring) {
+    // Forget rings of destroyed backends
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [](const Entry& entry) {
+                                    return entry.ring->IsClosed();
+                                  }),
+                   entries_.end());
+    entries_.push_back({backend_id, std::move(ring)});
+  }
+
+ private:
+  struct Entry {
+    uint64_t backend_id;
+    std::shared_ptr<Ring> ring;
+  };
+
+  std::vector<Entry> entries_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+static std::atomic<uint64_t> next_backend_id{0};
+
+AsyncLogBackend::AsyncLogBackend(timber::ILogBackend* sink, Params params)
+    : id_(next_backend_id.fetch_add(1)), sink_(sink), params_(params) {
+  WHEELS_VERIFY((params_.ring_capacity & (params_.ring_capacity - 1)) == 0,
+                "Ring capacity must be a power of 2");
+
+  worker_ = std::thread([this]() {
+    Work();
+  });
+}
+
+AsyncLogBackend::~AsyncLogBackend() {
+  stop_.store(true);
+  worker_.join();
+  DrainAll();
+
+  std::lock_guard guard(rings_mutex_);
+  for (auto& ring : rings_) {
+    ring->Close();
+  }
+}
+
+AsyncLogBackend::Ring* AsyncLogBackend::ThisThreadRing() {
+  // Backend ids are never reused, so rings of destroyed backends never match
+  static thread_local ThreadRings rings;
+
+  if (Ring* ring = rings.Find(id_)) {
+    return ring;
+  }
+
+  auto ring = AcquireRing();
+  rings.Add(id_, ring);
+  return ring.get();
+}
+
+std::shared_ptr<AsyncLogBackend::Ring> AsyncLogBackend::AcquireRing() {
+  std::lock_guard guard(rings_mutex_);
+
+  // Reuse ring of an exited thread, its pending events are still drained
+  for (auto& ring : rings_) {
+    if (ring->TryAcquire()) {
+      return ring;
+    }
+  }
+
+  auto ring = std::make_shared<Ring>(params_.ring_capacity);
+  ring->TryAcquire();
+  rings_.push_back(ring);
+  return ring;
+}
+
+void AsyncLogBackend::Log(timber::Event event) {
+  if (ThisThreadRing()->TryPush(std::move(event))) {
+    logged_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+size_t AsyncLogBackend::DrainAll() {
+  {
+    // Rings are never removed, so pointers stay valid after unlock
+    std::lock_guard guard(rings_mutex_);
+    drain_list_.resize(rings_.size());
+    for (size_t i = 0; i < rings_.size(); ++i) {
+      drain_list_[i] = rings_[i].get();
+    }
+  }
+
+  size_t drained = 0;
+  for (Ring* ring : drain_list_) {
+    drained += ring->Drain([this](timber::Event&& event) {
+      sink_->Log(std::move(event));
+    });
+  }
+  return drained;
+}
+
+void AsyncLogBackend::Work() {
+  while (!stop_.load()) {
+    if (DrainAll() == 0) {
+      std::this_thread::sleep_for(params_.idle_sleep);
+    }
+  }
+}
+
+void AsyncLogBackend::Flush() {
+  std::vector<std::pair<Ring*, size_t>> targets;
+  {
+    std::lock_guard guard(rings_mutex_);
+    for (auto& ring : rings_) {
+      targets.emplace_back(ring.get(), ring->Tail());
+    }
+  }
+
+  for (auto [ring, tail] : targets) {
+    while (ring->Head() < tail) {
+      std::this_thread::sleep_for(params_.idle_sleep);
+    }
+  }
+}
+
+}  // namespace whirl::logging
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <timber/backend.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace whirl::logging {
+
+// Asynchronous log backend for real engines (not for simulation:
+// background thread breaks determinism)
+//
+// Producers push events into per-thread lock-free SPSC ring buffers,
+// background thread drains them into the `sink` backend
+// Events are dropped (and counted) when a ring is full
+// Rings of exited threads are recycled, so the number of rings is bounded
+// by the number of concurrently logging threads
+
+class AsyncLogBackend : public timber::ILogBackend {
+ public:
+  struct Params {
+    // Per producer thread, power of 2
+    size_t ring_capacity = 4096;
+    // Background thread sleep when all rings are empty
+    std::chrono::microseconds idle_sleep{500};
+  };
+
+  struct Counters {
+    size_t logged;
+    size_t dropped;
+  };
+
+  AsyncLogBackend(timber::ILogBackend* sink, Params params);
+
+  explicit AsyncLogBackend(timber::ILogBackend* sink)
+      : AsyncLogBackend(sink, Params{}) {
+  }
+
+  // Drains pending events
+  ~AsyncLogBackend();
+
+  // Non-copyable
+  AsyncLogBackend(const AsyncLogBackend&) = delete;
+  AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+
+  // timber::ILogBackend
+
+  timber::Level GetMinLevelFor(const std::string& component) const override {
+    return sink_->GetMinLevelFor(component);
+  }
+
+  void Log(timber::Event event) override;
+
+  // Blocks until all events logged before the call reach the sink
+  void Flush();
+
+  Counters GetCounters() const {
+    return {logged_.load(), dropped_.load()};
+  }
+
+ private:
+  class Ring;
+  class ThreadRings;
+
+  Ring* ThisThreadRing();
+  std::shared_ptr<Ring> AcquireRing();
+
+  // Returns number of drained events
+  size_t DrainAll();
+  void Work();
+
+ private:
+  const uint64_t id_;
+  timber::ILogBackend* sink_;
+  const Params params_;
+
+  // Registration of producer threads
+  // Rings are shared with thread-local registries of producers:
+  // a thread may exit after the backend is destroyed and vice versa
+  std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  // Consumer-only copy of `rings_`
+  std::vector<Ring*> drain_list_;
+
+  std::atomic<size_t> logged_{0};
+  std::atomic<size_t> dropped_{0};
+
+  std::atomic<bool> stop_{false};
+  std::thread worker_;
+};
+
+}  // namespace whirl::logging
@@ -2,15 +2,48 @@
 
 #include <whirl/node/cluster/list.hpp>
 
+#include <cstdint>
 #include <memory>
 
 namespace whirl::node::cluster {
 
+// Incremental change of pool membership
+struct MembershipDelta {
+  // Pool version after this change
+  uint64_t version;
+  List added;
+  List removed;
+};
+
+struct IMembershipWatcher {
+  virtual ~IMembershipWatcher() = default;
+
+  // Deltas are delivered in version order
+  virtual void OnMembershipChange(const MembershipDelta& delta) = 0;
+};
+
 struct IDiscoveryService {
   virtual ~IDiscoveryService() = default;
 
   // Pool name -> list of hostnames
   virtual List ListPool(const std::string& name) = 0;
+
+  // Watch API
+  // Default implementation: static membership
+
+  // Version of the list returned by ListPool, 0 for static pools
+  virtual uint64_t PoolVersion(const std::string& /*name*/) {
+    return 0;
+  }
+
+  // Watcher receives deltas with version > PoolVersion(name)
+  virtual void Watch(const std::string& /*name*/,
+                     IMembershipWatcher* /*watcher*/) {
+  }
+
+  virtual void Unwatch(const std::string& /*name*/,
+                       IMembershipWatcher* /*watcher*/) {
+  }
 };
 
 }  // namespace whirl::node::cluster
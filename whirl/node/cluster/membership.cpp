@@ -0,0 +1,93 @@
+#include <whirl/node/cluster/membership.hpp>
+
+#include <algorithm>
+#include <set>
+
+namespace whirl::node::cluster {
+
+void Membership::Update(const std::string& name, List members) {
+  auto& pool = pools_[name];
+
+  std::set<std::string> current{pool.members.begin(), pool.members.end()};
+  std::set<std::string> next{members.begin(), members.end()};
+
+  List added;
+  List removed;
+
+  for (const auto& host : next) {
+    if (current.count(host) == 0) {
+      added.push_back(host);
+    }
+  }
+  for (const auto& host : current) {
+    if (next.count(host) == 0) {
+      removed.push_back(host);
+    }
+  }
+
+  Apply(pool, std::move(added), std::move(removed));
+}
+
+void Membership::Add(const std::string& name, const std::string& host) {
+  Apply(pools_[name], {host}, {});
+}
+
+void Membership::Remove(const std::string& name, const std::string& host) {
+  Apply(pools_[name], {}, {host});
+}
+
+void Membership::Apply(Pool& pool, List added, List removed) {
+  // Drop no-ops
+  auto member = [&pool](const std::string& host) {
+    return std::find(pool.members.begin(), pool.members.end(), host) !=
+           pool.members.end();
+  };
+  added.erase(std::remove_if(added.begin(), added.end(), member),
+              added.end());
+  removed.erase(std::remove_if(removed.begin(), removed.end(),
+                               [&](const auto& host) {
+                                 return !member(host);
+                               }),
+                removed.end());
+
+  if (added.empty() && removed.empty()) {
+    return;
+  }
+
+  for (const auto& host : removed) {
+    pool.members.erase(
+        std::find(pool.members.begin(), pool.members.end(), host));
+  }
+  for (const auto& host : added) {
+    pool.members.push_back(host);
+  }
+
+  MembershipDelta delta{++pool.version, std::move(added), std::move(removed)};
+
+  // Watchers may unsubscribe from callback
+  auto watchers = pool.watchers;
+  for (auto* watcher : watchers) {
+    watcher->OnMembershipChange(delta);
+  }
+}
+
+List Membership::ListPool(const std::string& name) {
+  return pools_[name].members;
+}
+
+uint64_t Membership::PoolVersion(const std::string& name) {
+  return pools_[name].version;
+}
+
+void Membership::Watch(const std::string& name, IMembershipWatcher* watcher) {
+  pools_[name].watchers.push_back(watcher);
+}
+
+void Membership::Unwatch(const std::string& name,
+                         IMembershipWatcher* watcher) {
+  auto& watchers = pools_[name].watchers;
+  watchers.erase(std::remove(watchers.begin(), watchers.end(), watcher),
+                 watchers.end());
+}
+
+}  // namespace whirl::node::cluster
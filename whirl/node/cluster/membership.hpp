@@ -0,0 +1,42 @@
+#pragma once
+
+#include <whirl/node/cluster/discovery.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace whirl::node::cluster {
+
+// Versioned pools with watchers, building block for discovery services
+// Not thread-safe
+
+class Membership : public IDiscoveryService {
+  struct Pool {
+    uint64_t version = 0;
+    List members;
+    std::vector<IMembershipWatcher*> watchers;
+  };
+
+ public:
+  // Replaces pool members, notifies watchers with the difference
+  void Update(const std::string& name, List members);
+
+  void Add(const std::string& name, const std::string& host);
+  void Remove(const std::string& name, const std::string& host);
+
+  // IDiscoveryService
+
+  List ListPool(const std::string& name) override;
+  uint64_t PoolVersion(const std::string& name) override;
+  void Watch(const std::string& name, IMembershipWatcher* watcher) override;
+  void Unwatch(const std::string& name, IMembershipWatcher* watcher) override;
+
+ private:
+  void Apply(Pool& pool, List added, List removed);
+
+ private:
+  std::map<std::string, Pool> pools_;
+};
+
+}  // namespace whirl::node::cluster
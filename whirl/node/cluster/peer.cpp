@@ -4,14 +4,33 @@
 
 #include <commute/rpc/retries.hpp>
 
+#include <wheels/support/assert.hpp>
+
 #include <fmt/core.h>
 
+#include <algorithm>
+
 namespace whirl::node::cluster {
 
+static commute::rpc::BackoffParams RetriesBackoff(cfg::IConfig* config) {
+  return {config->GetInt<uint64_t>("rpc.backoff.init"),
+          config->GetInt<uint64_t>("rpc.backoff.max"),
+          config->GetInt<uint64_t>("rpc.backoff.factor")};
+}
+
 Peer::Peer(cfg::IConfig* config)
-    : pool_name_(config->GetString("pool.name")),
-      port_(config->GetInt<uint16_t>("rpc.port")) {
-  ConnectToPeers(config);
+    : discovery_(rt::Discovery()),
+      host_(rt::HostName()),
+      time_(rt::TimeService()),
+      logger_(rt::LoggerBackend()),
+      pool_name_(config->GetString("pool.name")),
+      port_(config->GetInt<uint16_t>("rpc.port")),
+      backoff_(RetriesBackoff(config)) {
+  ConnectToPeers();
+}
+
+Peer::~Peer() {
+  discovery_->Unwatch(pool_name_, this);
 }
 
 size_t Peer::NodeCount() const {
@@ -26,14 +45,15 @@ const List& Peer::ListImpl(bool with_me) const {
   }
 }
 
-const ::commute::rpc::IChannelPtr& Peer::Channel(
-    const std::string& peer) const {
+::commute::rpc::IChannelPtr Peer::Channel(const std::string& peer) const {
   auto it = channels_.find(peer);
-  return it->second;  // Or UB =(
+  WHEELS_VERIFY(it != channels_.end(),
+                fmt::format("Peer '{}' is not a member of the pool", peer));
+  return it->second;
 }
 
-const ::commute::rpc::IChannelPtr& Peer::LoopBack() const {
-  return Channel(rt::HostName());
+::commute::rpc::IChannelPtr Peer::LoopBack() const {
+  return Channel(host_);
 }
 
 ::commute::rpc::IClientPtr Peer::MakeRpcClient() {
@@ -41,27 +61,65 @@ const ::commute::rpc::IChannelPtr& Peer::LoopBack() const {
                                     rt::LoggerBackend());
 }
 
-void Peer::ConnectToPeers(cfg::IConfig* cfg) {
-  pool_ = rt::Discovery()->ListPool(pool_name_);
+void Peer::ConnectToPeers() {
+  // Deltas with version <= version_ are already reflected in pool_
+  discovery_->Watch(pool_name_, this);
+  version_ = discovery_->PoolVersion(pool_name_);
 
-  auto client = MakeRpcClient();
+  client_ = MakeRpcClient();
 
-  // others_ = pool_ \ {rt::HostName()}
-  for (const auto& host : pool_) {
-    if (host != rt::HostName()) {
-      others_.push_back(host);
-    }
+  for (const auto& host : discovery_->ListPool(pool_name_)) {
+    AddPeer(host);
   }
+}
 
-  for (const auto& host : pool_) {
-    channels_.emplace(host, MakeRpcChannel(client, host, cfg));
+void Peer::OnMembershipChange(const MembershipDelta& delta) {
+  if (delta.version <= version_) {
+    return;  // Stale
+  }
+  version_ = delta.version;
+
+  for (const auto& host : delta.removed) {
+    RemovePeer(host);
+  }
+  for (const auto& host : delta.added) {
+    AddPeer(host);
   }
 }
 
-static commute::rpc::BackoffParams RetriesBackoff(cfg::IConfig* config) {
-  return {config->GetInt<uint64_t>("rpc.backoff.init"),
-          config->GetInt<uint64_t>("rpc.backoff.max"),
-          config->GetInt<uint64_t>("rpc.backoff.factor")};
+void Peer::AddPeer(const std::string& host) {
+  if (channels_.count(host) > 0) {
+    return;
+  }
+
+  pool_.push_back(host);
+  // others_ = pool_ \ {host_}
+  if (host != host_) {
+    others_.push_back(host);
+  }
+  channels_.emplace(host, MakeRpcChannel(client_, host));
+}
+
+static void Erase(List& list, const std::string& host) {
+  list.erase(std::remove(list.begin(), list.end(), host), list.end());
+}
+
+void Peer::RemovePeer(const std::string& host) {
+  if (host == host_) {
+    // LoopBack channel stays valid while this node is alive
+    return;
+  }
+
+  auto it = channels_.find(host);
+  if (it == channels_.end()) {
+    return;
+  }
+
+  it->second->Close();
+  channels_.erase(it);
+
+  Erase(pool_, host);
+  Erase(others_, host);
 }
 
 static std::string PeerAddress(const std::string& host, uint16_t port) {
@@ -69,12 +127,10 @@ static std::string PeerAddress(const std::string& host, uint16_t port) {
 }
 
 ::commute::rpc::IChannelPtr Peer::MakeRpcChannel(
-    ::commute::rpc::IClientPtr client, const std::string& host,
-    cfg::IConfig* config) {
+    ::commute::rpc::IClientPtr client, const std::string& host) {
   auto transport = client->Dial(PeerAddress(host, port_));
   auto retries =
-      commute::rpc::WithRetries(std::move(transport), rt::TimeService(),
-                                rt::LoggerBackend(), RetriesBackoff(config));
+      commute::rpc::WithRetries(std::move(transport), time_, logger_, backoff_);
   return retries;
 }
 
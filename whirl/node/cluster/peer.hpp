@@ -1,11 +1,16 @@
 #pragma once
 
 #include <whirl/node/cluster/list.hpp>
+#include <whirl/node/cluster/discovery.hpp>
 
 #include <whirl/node/config/config.hpp>
+#include <whirl/node/time/time_service.hpp>
 
 #include <commute/rpc/client.hpp>
 #include <commute/rpc/channel.hpp>
+#include <commute/rpc/retries.hpp>
+
+#include <timber/backend.hpp>
 
 #include <string>
 #include <map>
@@ -13,7 +18,7 @@
 
 namespace whirl::node::cluster {
 
-class Peer {
+class Peer : private IMembershipWatcher {
  private:
   class [[nodiscard]] Lister {
    public:
@@ -36,6 +41,11 @@ class Peer {
 
  public:
   explicit Peer(cfg::IConfig* config);
+  ~Peer();
+
+  // Non-copyable: registered as membership watcher
+  Peer(const Peer&) = delete;
+  Peer& operator=(const Peer&) = delete;
 
   friend class Lister;
 
@@ -49,23 +59,49 @@ class Peer {
     return Lister{this};
   }
 
-  const commute::rpc::IChannelPtr& Channel(const std::string& peer) const;
-  const commute::rpc::IChannelPtr& LoopBack() const;
+  // ListPeers().WithoutMe() without copying (e.g. for broadcasts)
+  // Reference is valid until the next membership change
+  const List& OthersView() const {
+    return ListImpl(/*with_me=*/false);
+  }
+
+  // Channels of removed peers are closed on membership change
+  // Returned by value: channel map changes with membership
+  commute::rpc::IChannelPtr Channel(const std::string& peer) const;
+  commute::rpc::IChannelPtr LoopBack() const;
 
  private:
   const List& ListImpl(bool with_me) const;
 
   commute::rpc::IClientPtr MakeRpcClient();
   commute::rpc::IChannelPtr MakeRpcChannel(commute::rpc::IClientPtr client,
-                                           const std::string& host,
-                                           cfg::IConfig* config);
+                                           const std::string& host);
 
-  void ConnectToPeers(cfg::IConfig* config);
+  void ConnectToPeers();
+
+  // IMembershipWatcher
+  void OnMembershipChange(const MembershipDelta& delta) override;
+
+  void AddPeer(const std::string& host);
+  void RemovePeer(const std::string& host);
 
  private:
+  // Cached: Peer may outlive the runtime binding of its fiber,
+  // membership changes are delivered outside of it
+  IDiscoveryService* discovery_;
+  const std::string host_;
+  time::ITimeService* time_;
+  timber::ILogBackend* logger_;
+
   const std::string pool_name_;
   uint16_t port_;
+  // Resolved once for all channels
+  const commute::rpc::BackoffParams backoff_;
+
+  commute::rpc::IClientPtr client_;
 
+  // Membership version of pool_
+  uint64_t version_ = 0;
   List pool_;
   List others_;  // pool without this node
 
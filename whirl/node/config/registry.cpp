@@ -0,0 +1,45 @@
+#include <whirl/node/config/registry.hpp>
+
+namespace whirl::node::cfg {
+
+bool Registry::Resolve(Slot& slot) {
+  int64_t value = 0;
+
+  switch (slot.kind) {
+    case Slot::Kind::Integer:
+      value = config_->GetInt64(slot.key);
+      break;
+    case Slot::Kind::Bool:
+      value = config_->GetBool(slot.key) ? 1 : 0;
+      break;
+    case Slot::Kind::String:
+      slot.string = config_->GetString(slot.key);
+      return false;
+  }
+
+  return slot.number.exchange(value, std::memory_order_relaxed) != value;
+}
+
+void Registry::Reload() {
+  std::vector<std::function<void()>> notify;
+
+  {
+    std::lock_guard guard(mutex_);
+    for (auto& slot : slots_) {
+      if (slot.kind == Slot::Kind::String) {
+        continue;  // Handles expose string views
+      }
+      if (Resolve(slot)) {
+        notify.insert(notify.end(), slot.listeners.begin(),
+                      slot.listeners.end());
+      }
+    }
+  }
+
+  // Listeners may read other handles
+  for (auto& listener : notify) {
+    listener();
+  }
+}
+
+}  // namespace whirl::node::cfg
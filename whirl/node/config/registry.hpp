@@ -0,0 +1,136 @@
+#pragma once
+
+#include <whirl/node/config/config.hpp>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace whirl::node::cfg {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Resolved value of a single key
+struct Slot {
+  enum class Kind { Integer, Bool, String };
+
+  Slot(Kind k, std::string name) : kind(k), key(std::move(name)) {
+  }
+
+  const Kind kind;
+  const std::string key;
+
+  // Integers and booleans, hot-reloadable
+  std::atomic<int64_t> number{0};
+  // Strings are resolved once
+  std::string string;
+
+  std::vector<std::function<void()>> listeners;
+};
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Typed handle to a resolved config value
+// Reads are a single relaxed atomic load: no lookups, no allocations
+
+// Usage:
+// cfg::Registry registry{rt::Config()};
+// auto backoff_init = registry.Bind<uint64_t>("rpc.backoff.init");
+// backoff_init.Get();
+
+class Registry;
+
+template <typename T>
+class ConfigKey {
+  using Slot = detail::Slot;
+
+  friend class Registry;
+
+  static_assert(std::is_integral_v<T> || std::is_same_v<T, std::string>,
+                "Integers, booleans and strings are supported");
+
+ public:
+  explicit ConfigKey(Slot* slot) : slot_(slot) {
+  }
+
+  auto Get() const {
+    if constexpr (std::is_same_v<T, std::string>) {
+      return std::string_view{slot_->string};
+    } else if constexpr (std::is_same_v<T, bool>) {
+      return slot_->number.load(std::memory_order_relaxed) != 0;
+    } else {
+      return static_cast<T>(slot_->number.load(std::memory_order_relaxed));
+    }
+  }
+
+  const std::string& Name() const {
+    return slot_->key;
+  }
+
+ private:
+  Slot* slot_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class Registry {
+  using Slot = detail::Slot;
+
+ public:
+  explicit Registry(IConfig* config) : config_(config) {
+  }
+
+  // Non-copyable: handles point into registry
+  Registry(const Registry&) = delete;
+  Registry& operator=(const Registry&) = delete;
+
+  // Resolves `key` once
+  template <typename T>
+  ConfigKey<T> Bind(Key key) {
+    std::lock_guard guard(mutex_);
+    Slot& slot = slots_.emplace_back(KindOf<T>(), std::string{key});
+    Resolve(slot);
+    return ConfigKey<T>{&slot};
+  }
+
+  // Invoked after Reload changes value of `key`
+  template <typename T>
+  void OnChange(const ConfigKey<T>& key, std::function<void()> listener) {
+    std::lock_guard guard(mutex_);
+    key.slot_->listeners.push_back(std::move(listener));
+  }
+
+  // Re-reads integers and booleans, notifies listeners of changed ones
+  void Reload();
+
+ private:
+  template <typename T>
+  static Slot::Kind KindOf() {
+    if constexpr (std::is_same_v<T, std::string>) {
+      return Slot::Kind::String;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      return Slot::Kind::Bool;
+    } else {
+      return Slot::Kind::Integer;
+    }
+  }
+
+  // Returns true if value changed
+  bool Resolve(Slot& slot);
+
+ private:
+  IConfig* config_;
+  std::mutex mutex_;
+  // Stable addresses
+  std::deque<Slot> slots_;
+};
+
+}  // namespace whirl::node::cfg
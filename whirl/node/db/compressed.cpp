@@ -0,0 +1,296 @@
+#include <whirl/node/db/compressed.hpp>
+
+#include <whirl/compress/lz.hpp>
+#include <whirl/clocks/posix.hpp>
+
+#include <wheels/support/assert.hpp>
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+namespace whirl::node::db {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+enum Tag : char {
+  kRaw = 0,
+  kLz = 1,
+};
+
+class Codec {
+ public:
+  Codec(CompressionParams params, CompressionStats* stats)
+      : params_(std::move(params)), stats_(stats) {
+  }
+
+  bool Covers(KeyView key) const {
+    for (const auto& prefix : params_.prefixes) {
+      if (key.starts_with(prefix)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Value Encode(KeyView key, const Value& value) const {
+    if (!Covers(key)) {
+      return value;
+    }
+
+    Value stored;
+
+    if (value.size() >= params_.min_size) {
+      uint64_t start = clocks::MonotonicNanos();
+
+      stored.push_back(kLz);
+      PutVarint(stored, value.size());
+      compress::lz::Compress(value, stored);
+
+      stats_->compress_nanos += clocks::MonotonicNanos() - start;
+    }
+
+    if (stored.empty() || stored.size() >= value.size() + 1) {
+      // Too small or incompressible
+      stored.clear();
+      stored.push_back(kRaw);
+      stored.append(value);
+      ++stats_->values_stored_raw;
+    } else {
+      ++stats_->values_compressed;
+    }
+
+    stats_->raw_bytes += value.size();
+    stats_->stored_bytes += stored.size();
+
+    return stored;
+  }
+
+  Value Decode(KeyView key, ValueView stored) const {
+    if (!Covers(key)) {
+      return Value{stored};
+    }
+
+    if (stored.empty()) {
+      Corrupted(key);
+    }
+
+    switch (stored[0]) {
+      case kRaw:
+        return Value{stored.substr(1)};
+
+      case kLz: {
+        uint64_t start = clocks::MonotonicNanos();
+
+        ValueView block = stored.substr(1);
+        auto size = GetVarint(block);
+        if (!size.has_value()) {
+          Corrupted(key);
+        }
+        auto value = compress::lz::Decompress(block, *size);
+        if (!value.has_value()) {
+          Corrupted(key);
+        }
+
+        stats_->decompress_nanos += clocks::MonotonicNanos() - start;
+        return std::move(*value);
+      }
+
+      default:
+        Corrupted(key);
+    }
+  }
+
+ private:
+  static void PutVarint(Value& output, uint64_t value) {
+    while (value >= 0x80) {
+      output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    output.push_back(static_cast<char>(value));
+  }
+
+  static std::optional<uint64_t> GetVarint(ValueView& input) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < input.size() && i < 10; ++i) {
+      uint8_t byte = input[i];
+      value |= uint64_t(byte & 0x7F) << (7 * i);
+      if ((byte & 0x80) == 0) {
+        input.remove_prefix(i + 1);
+        return value;
+      }
+    }
+    return std::nullopt;
+  }
+
+  [[noreturn]] static void Corrupted(KeyView key) {
+    WHEELS_PANIC(fmt::format("Corrupted compressed value for key '{}'", key));
+  }
+
+ private:
+  const CompressionParams params_;
+  CompressionStats* stats_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class DecompressingIterator : public IIterator {
+ public:
+  DecompressingIterator(IIteratorPtr it, const Codec* codec)
+      : it_(std::move(it)), codec_(codec) {
+  }
+
+  bool Valid() const override {
+    return it_->Valid();
+  }
+
+  KeyView Key() const override {
+    return it_->Key();
+  }
+
+  // Decoded lazily, valid until the next move
+  ValueView Value() const override {
+    if (!value_.has_value()) {
+      value_ = codec_->Decode(it_->Key(), it_->Value());
+    }
+    return *value_;
+  }
+
+  void Seek(const db::Key& target) override {
+    value_.reset();
+    it_->Seek(target);
+  }
+
+  void SeekToLast() override {
+    value_.reset();
+    it_->SeekToLast();
+  }
+
+  void SeekToFirst() override {
+    value_.reset();
+    it_->SeekToFirst();
+  }
+
+  void Next() override {
+    value_.reset();
+    it_->Next();
+  }
+
+  void Prev() override {
+    value_.reset();
+    it_->Prev();
+  }
+
+ private:
+  IIteratorPtr it_;
+  const Codec* codec_;
+  mutable std::optional<db::Value> value_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class DecompressingSnapshot : public ISnapshot {
+ public:
+  DecompressingSnapshot(ISnapshotPtr snapshot, const Codec* codec)
+      : snapshot_(std::move(snapshot)), codec_(codec) {
+  }
+
+  std::optional<Value> TryGet(const Key& key) const override {
+    auto stored = snapshot_->TryGet(key);
+    if (!stored.has_value()) {
+      return std::nullopt;
+    }
+    return codec_->Decode(key, *stored);
+  }
+
+  IIteratorPtr MakeIterator() override {
+    return std::make_shared<DecompressingIterator>(snapshot_->MakeIterator(),
+                                                   codec_);
+  }
+
+ private:
+  ISnapshotPtr snapshot_;
+  const Codec* codec_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class CompressingDatabase : public IDatabase {
+ public:
+  CompressingDatabase(IDatabase* db, CompressionParams params,
+                      CompressionStats* stats)
+      : db_(db), codec_(std::move(params), stats) {
+  }
+
+  void Open(const std::string& directory) override {
+    db_->Open(directory);
+  }
+
+  void Put(const Key& key, const Value& value) override {
+    db_->Put(key, codec_.Encode(key, value));
+  }
+
+  std::optional<Value> TryGet(const Key& key) const override {
+    auto stored = db_->TryGet(key);
+    if (!stored.has_value()) {
+      return std::nullopt;
+    }
+    return codec_.Decode(key, *stored);
+  }
+
+  void Delete(const Key& key) override {
+    db_->Delete(key);
+  }
+
+  void Merge(const Key& key, const Value& operand) override {
+    VerifyNotCompressed(key);
+    db_->Merge(key, operand);
+  }
+
+  bool SupportsMerge() const override {
+    return db_->SupportsMerge();
+  }
+
+  void Write(WriteBatch batch) override {
+    VerifyMergeSupport(*db_, batch);
+    for (auto& mut : batch.muts) {
+      if (mut.type == MutationType::Put) {
+        mut.value = codec_.Encode(mut.key, *mut.value);
+      } else if (mut.type == MutationType::Merge) {
+        VerifyNotCompressed(mut.key);
+      }
+    }
+    db_->Write(std::move(batch));
+  }
+
+  // Snapshot must not outlive the database
+  ISnapshotPtr MakeSnapshot() override {
+    return std::make_shared<DecompressingSnapshot>(db_->MakeSnapshot(),
+                                                   &codec_);
+  }
+
+ private:
+  void VerifyNotCompressed(KeyView key) const {
+    // Merge operators below would see compressed values
+    WHEELS_VERIFY(!codec_.Covers(key),
+                  "Merge on compressed key: resolve merges above "
+                  "compressing database");
+  }
+
+ private:
+  IDatabase* db_;
+  Codec codec_;
+};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<IDatabase> MakeCompressingDatabase(IDatabase* db,
+                                                   CompressionParams params,
+                                                   CompressionStats* stats) {
+  return std::make_unique<CompressingDatabase>(db, std::move(params), stats);
+}
+
+}  // namespace whirl::node::db
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <whirl/node/db/database.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace whirl::node::db {
+
+struct CompressionParams {
+  // Values under these key prefixes (namespaces) are compressed,
+  // e.g. "kv:log:" for KVStore<V>(db, "log")
+  std::vector<std::string> prefixes;
+  // Smaller values are stored raw
+  size_t min_size = 64;
+};
+
+struct CompressionStats {
+  size_t values_compressed = 0;
+  // Incompressible or too small
+  size_t values_stored_raw = 0;
+
+  size_t raw_bytes = 0;
+  size_t stored_bytes = 0;
+
+  // Host CPU time, not simulated time
+  uint64_t compress_nanos = 0;
+  uint64_t decompress_nanos = 0;
+
+  double Ratio() const {
+    if (stored_bytes == 0) {
+      return 1.0;
+    }
+    return static_cast<double>(raw_bytes) / stored_bytes;
+  }
+};
+
+// Transparent block compression of values
+// Values under configured prefixes are stored as
+// [tag: raw / lz][varint raw size][lz block]
+// Other values are passed through unchanged
+//
+// Must wrap the database from the start: existing raw values under
+// compressed prefixes are not readable
+//
+// Snapshots and iterators decompress on read, so they do not save
+// bytes on their own. To ship compressed values (e.g. snapshot
+// transfer), snapshot the underlying `db` and install the stored
+// values into a database wrapped with the same params
+//
+// With merges: merging database (db/merge.hpp) goes on top of this one
+
+std::unique_ptr<IDatabase> MakeCompressingDatabase(IDatabase* db,
+                                                   CompressionParams params,
+                                                   CompressionStats* stats);
+
+}  // namespace whirl::node::db
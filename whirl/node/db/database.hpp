@@ -4,6 +4,8 @@
 #include <whirl/node/db/write_batch.hpp>
 #include <whirl/node/db/snapshot.hpp>
 
+#include <wheels/support/panic.hpp>
+
 #include <optional>
 
 namespace whirl::node::db {
@@ -23,11 +25,34 @@ struct IDatabase {
   virtual std::optional<Value> TryGet(const Key& key) const = 0;
   virtual void Delete(const Key& key) = 0;
 
+  // Blind read-modify-write: operand is combined with existing value
+  // by the merge operator registered for the key, see db/merge.hpp
+  // Supported by MergingDatabase (and MemoryDatabase with operators),
+  // decorators forward it
+  virtual void Merge(const Key& /*key*/, const Value& /*operand*/) {
+    WHEELS_PANIC("Merge requires MergingDatabase");
+  }
+
+  // Merge mutations are accepted by Merge / Write
+  virtual bool SupportsMerge() const {
+    return false;
+  }
+
   // Multi-key atomic write
+  // Batch with Merge mutations requires SupportsMerge(),
+  // implementations check it with VerifyMergeSupport
   virtual void Write(WriteBatch batch) = 0;
 
   // Immutable snapshots, iteration
   virtual ISnapshotPtr MakeSnapshot() = 0;
 };
 
+// Panics if `batch` contains Merge mutations not supported by `db`:
+// plain database would store operands as values
+inline void VerifyMergeSupport(const IDatabase& db, const WriteBatch& batch) {
+  if (!db.SupportsMerge() && batch.HasMerges()) {
+    WHEELS_PANIC("Merge mutation in WriteBatch requires MergingDatabase");
+  }
+}
+
 }  // namespace whirl::node::db
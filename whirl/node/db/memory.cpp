@@ -0,0 +1,486 @@
+#include <whirl/node/db/memory.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <string_view>
+#include <utility>
+
+namespace whirl::node::db {
+
+namespace memory {
+
+//////////////////////////////////////////////////////////////////////
+
+// Node free list
+// Recycled nodes hold no payload: only fixed-size nodes are kept
+
+static const size_t kMaxFreeNodes = 4096;
+
+// Trivially destructible: stays accessible during thread teardown, when
+// Roots owned by other thread-local / static objects are destroyed
+struct FreeList {
+  Node* head = nullptr;  // Linked via Node::left
+  size_t size = 0;
+  bool closed = false;   // Reaper has run, free nodes directly
+};
+
+static thread_local FreeList free_list;
+
+// Drains the free list on thread exit
+struct FreeListReaper {
+  ~FreeListReaper() {
+    while (free_list.head != nullptr) {
+      delete std::exchange(free_list.head, free_list.head->left);
+    }
+    free_list.size = 0;
+    free_list.closed = true;
+  }
+};
+
+static thread_local FreeListReaper reaper;
+
+static Entry* Ref(Entry* entry) {
+  ++entry->refs;
+  return entry;
+}
+
+static void Unref(Entry* entry) {
+  if (--entry->refs == 0) {
+    delete entry;
+  }
+}
+
+// Adopts reference to `entry`
+static Node* NewNode(Entry* entry, uint64_t priority) {
+  Node* node = free_list.head;
+  if (node != nullptr) {
+    free_list.head = node->left;
+    --free_list.size;
+    *node = Node{entry, priority};
+  } else {
+    node = new Node{entry, priority};
+  }
+  return node;
+}
+
+static Node* Ref(Node* node) {
+  if (node != nullptr) {
+    ++node->refs;
+  }
+  return node;
+}
+
+static void Recycle(Node* node) {
+  Unref(std::exchange(node->entry, nullptr));
+
+  // Odr-use registers the reaper of this thread
+  FreeListReaper* guard = &reaper;
+  (void)guard;
+
+  if (!free_list.closed && free_list.size < kMaxFreeNodes) {
+    node->left = free_list.head;
+    free_list.head = node;
+    ++free_list.size;
+  } else {
+    delete node;
+  }
+}
+
+static void Unref(Node* node) {
+  if (node == nullptr || --node->refs > 0) {
+    return;
+  }
+
+  // Iterative: released subtrees may be deep
+  std::vector<Node*> released{node};
+  while (!released.empty()) {
+    Node* next = released.back();
+    released.pop_back();
+
+    for (Node* child : {next->left, next->right}) {
+      if (child != nullptr && --child->refs == 0) {
+        released.push_back(child);
+      }
+    }
+
+    Recycle(next);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Root::Root(Node* node) : node_(node) {
+}
+
+Root::Root(const Root& that) : node_(Ref(that.node_)) {
+}
+
+Root::Root(Root&& that) : node_(that.Release()) {
+}
+
+Root& Root::operator=(Root that) {
+  std::swap(node_, that.node_);
+  return *this;
+}
+
+Root::~Root() {
+  Unref(node_);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Persistent treap operations
+// Take ownership of argument references, return owned references
+
+static uint64_t Priority(std::string_view key) {
+  // FNV-1a + finalizer
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Shallow copy of shared node (children are shared)
+static Node* Mutable(Node* node) {
+  if (node->refs == 1) {
+    return node;  // Exclusively owned: update in place
+  }
+  Node* copy = NewNode(Ref(node->entry), node->priority);
+  copy->left = Ref(node->left);
+  copy->right = Ref(node->right);
+  --node->refs;
+  return copy;
+}
+
+// -> (< key, > key), node with `key` is released
+static std::pair<Node*, Node*> Split(Node* node, std::string_view key) {
+  if (node == nullptr) {
+    return {nullptr, nullptr};
+  }
+
+  if (key == node->entry->key) {
+    Node* left = Ref(node->left);
+    Node* right = Ref(node->right);
+    Unref(node);
+    return {left, right};
+  }
+
+  node = Mutable(node);
+  if (key < node->entry->key) {
+    auto [left, right] = Split(node->left, key);
+    node->left = right;
+    return {left, node};
+  } else {
+    auto [left, right] = Split(node->right, key);
+    node->right = left;
+    return {node, right};
+  }
+}
+
+// All keys in `left` < all keys in `right`
+static Node* Join(Node* left, Node* right) {
+  if (left == nullptr) {
+    return right;
+  }
+  if (right == nullptr) {
+    return left;
+  }
+
+  if (left->priority > right->priority) {
+    left = Mutable(left);
+    left->right = Join(left->right, right);
+    return left;
+  } else {
+    right = Mutable(right);
+    right->left = Join(left, right->left);
+    return right;
+  }
+}
+
+// `inserted` - new node without children
+static Node* Insert(Node* node, Node* inserted, bool& replaced) {
+  if (node == nullptr) {
+    return inserted;
+  }
+
+  if (node->entry->key == inserted->entry->key) {
+    inserted->left = Ref(node->left);
+    inserted->right = Ref(node->right);
+    Unref(node);
+    replaced = true;
+    return inserted;
+  }
+
+  if (inserted->priority > node->priority) {
+    // Node with the same key would have the same priority,
+    // so it is not in this subtree
+    auto [left, right] = Split(node, inserted->entry->key);
+    inserted->left = left;
+    inserted->right = right;
+    return inserted;
+  }
+
+  node = Mutable(node);
+  if (inserted->entry->key < node->entry->key) {
+    node->left = Insert(node->left, inserted, replaced);
+  } else {
+    node->right = Insert(node->right, inserted, replaced);
+  }
+  return node;
+}
+
+static Node* Erase(Node* node, std::string_view key, bool& erased) {
+  if (node == nullptr) {
+    return nullptr;
+  }
+
+  if (key == node->entry->key) {
+    Node* joined = Join(Ref(node->left), Ref(node->right));
+    Unref(node);
+    erased = true;
+    return joined;
+  }
+
+  // Avoid copying path to absent key
+  const Node* probe = node;
+  while (probe != nullptr && probe->entry->key != key) {
+    probe = (key < probe->entry->key) ? probe->left : probe->right;
+  }
+  if (probe == nullptr) {
+    return node;
+  }
+
+  node = Mutable(node);
+  if (key < node->entry->key) {
+    node->left = Erase(node->left, key, erased);
+  } else {
+    node->right = Erase(node->right, key, erased);
+  }
+  return node;
+}
+
+static const Node* Find(const Node* node, std::string_view key) {
+  while (node != nullptr) {
+    if (key == node->entry->key) {
+      return node;
+    }
+    node = (key < node->entry->key) ? node->left : node->right;
+  }
+  return nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// In-order walk over immutable version
+// `path_` - nodes from the root to the current one
+
+class TreeIterator : public IIterator {
+ public:
+  explicit TreeIterator(Root root) : root_(std::move(root)) {
+  }
+
+  bool Valid() const override {
+    return !path_.empty();
+  }
+
+  KeyView Key() const override {
+    return path_.back()->entry->key;
+  }
+
+  ValueView Value() const override {
+    return path_.back()->entry->value;
+  }
+
+  void Seek(const db::Key& target) override {
+    // Lower bound: descend, truncate path to the last node >= target
+    path_.clear();
+    size_t bound = 0;
+    for (const Node* node = root_.Get(); node != nullptr;) {
+      path_.push_back(node);
+      if (node->entry->key < target) {
+        node = node->right;
+      } else {
+        bound = path_.size();
+        if (node->entry->key == target) {
+          break;
+        }
+        node = node->left;
+      }
+    }
+    path_.resize(bound);
+  }
+
+  void SeekToFirst() override {
+    path_.clear();
+    DescendLeft(root_.Get());
+  }
+
+  void SeekToLast() override {
+    path_.clear();
+    DescendRight(root_.Get());
+  }
+
+  void Next() override {
+    const Node* current = path_.back();
+    if (current->right != nullptr) {
+      DescendLeft(current->right);
+      return;
+    }
+    // Up while coming from the right subtree
+    path_.pop_back();
+    while (!path_.empty() && path_.back()->right == current) {
+      current = path_.back();
+      path_.pop_back();
+    }
+  }
+
+  void Prev() override {
+    const Node* current = path_.back();
+    if (current->left != nullptr) {
+      DescendRight(current->left);
+      return;
+    }
+    path_.pop_back();
+    while (!path_.empty() && path_.back()->left == current) {
+      current = path_.back();
+      path_.pop_back();
+    }
+  }
+
+ private:
+  void DescendLeft(const Node* node) {
+    for (; node != nullptr; node = node->left) {
+      path_.push_back(node);
+    }
+  }
+
+  void DescendRight(const Node* node) {
+    for (; node != nullptr; node = node->right) {
+      path_.push_back(node);
+    }
+  }
+
+ private:
+  Root root_;
+  std::vector<const Node*> path_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class Snapshot : public ISnapshot {
+ public:
+  explicit Snapshot(Root root) : root_(std::move(root)) {
+  }
+
+  std::optional<Value> TryGet(const Key& key) const override {
+    if (const Node* node = Find(root_.Get(), key)) {
+      return node->entry->value;
+    }
+    return std::nullopt;
+  }
+
+  IIteratorPtr MakeIterator() override {
+    return std::make_shared<TreeIterator>(root_);
+  }
+
+ private:
+  Root root_;
+};
+
+}  // namespace memory
+
+//////////////////////////////////////////////////////////////////////
+
+MemoryDatabase::MemoryDatabase(const MergeOperators* operators)
+    : operators_(operators) {
+}
+
+void MemoryDatabase::Open(const std::string& /*directory*/) {
+}
+
+void MemoryDatabase::Apply(memory::Root& root, Mutation& mut) {
+  switch (mut.type) {
+    case MutationType::Merge: {
+      WHEELS_VERIFY(operators_ != nullptr, "Merge operators not provided");
+      std::optional<ValueView> existing;
+      if (const auto* node = memory::Find(root.Get(), mut.key)) {
+        existing = node->entry->value;
+      }
+      mut.value = ApplyMerges(*operators_, mut.key, existing, {*mut.value});
+      [[fallthrough]];
+    }
+
+    case MutationType::Put: {
+      bool replaced = false;
+      auto* entry = new memory::Entry{std::move(mut.key),
+                                      std::move(*mut.value)};
+      auto* inserted =
+          memory::NewNode(entry, memory::Priority(entry->key));
+      root = memory::Root{memory::Insert(root.Release(), inserted, replaced)};
+      if (!replaced) {
+        ++size_;
+      }
+      break;
+    }
+
+    case MutationType::Delete: {
+      bool erased = false;
+      root = memory::Root{memory::Erase(root.Release(), mut.key, erased)};
+      if (erased) {
+        --size_;
+      }
+      break;
+    }
+  }
+}
+
+void MemoryDatabase::Put(const Key& key, const Value& value) {
+  Mutation mut{MutationType::Put, key, value};
+  Apply(root_, mut);
+}
+
+std::optional<Value> MemoryDatabase::TryGet(const Key& key) const {
+  if (const auto* node = memory::Find(root_.Get(), key)) {
+    return node->entry->value;
+  }
+  return std::nullopt;
+}
+
+void MemoryDatabase::Delete(const Key& key) {
+  Mutation mut{MutationType::Delete, key, std::nullopt};
+  Apply(root_, mut);
+}
+
+void MemoryDatabase::Merge(const Key& key, const Value& operand) {
+  Mutation mut{MutationType::Merge, key, operand};
+  Apply(root_, mut);
+}
+
+void MemoryDatabase::Write(WriteBatch batch) {
+  // Before the first mutation: batch is atomic
+  VerifyMergeSupport(*this, batch);
+
+  // Single-threaded: readers observe either snapshots (shared nodes are
+  // copied on write) or the state after the whole batch
+  for (auto& mut : batch.muts) {
+    Apply(root_, mut);
+  }
+}
+
+ISnapshotPtr MemoryDatabase::MakeSnapshot() {
+  return std::make_shared<memory::Snapshot>(root_);
+}
+
+std::unique_ptr<MemoryDatabase> MemoryDatabase::Fork() const {
+  auto fork = std::make_unique<MemoryDatabase>(operators_);
+  fork->root_ = root_;
+  fork->size_ = size_;
+  return fork;
+}
+
+}  // namespace whirl::node::db
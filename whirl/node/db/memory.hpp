@@ -0,0 +1,109 @@
+#pragma once
+
+#include <whirl/node/db/database.hpp>
+#include <whirl/node/db/merge.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace whirl::node::db {
+
+namespace memory {
+
+// Intrusive non-atomic reference counting: versions of a database
+// must be used from a single thread
+
+// Immutable key-value payload, shared by copies of a node:
+// path copying does not copy keys and values
+struct Entry {
+  Key key;
+  Value value;
+  size_t refs = 1;
+};
+
+// Persistent (path-copying) treap node, shared between versions
+struct Node {
+  Entry* entry;
+  uint64_t priority;
+  Node* left = nullptr;
+  Node* right = nullptr;
+  size_t refs = 1;
+};
+
+// Owning reference to immutable tree version
+class Root {
+ public:
+  Root() = default;
+  explicit Root(Node* node);  // Adopts reference
+  Root(const Root& that);
+  Root(Root&& that);
+  Root& operator=(Root that);
+  ~Root();
+
+  const Node* Get() const {
+    return node_;
+  }
+
+  Node* Release() {
+    return std::exchange(node_, nullptr);
+  }
+
+ private:
+  Node* node_ = nullptr;
+};
+
+}  // namespace memory
+
+//////////////////////////////////////////////////////////////////////
+
+// In-memory ordered database for simulations
+//
+// Persistent treap with path copying:
+// - Writes copy O(log n) nodes, payloads (key, value) are shared
+//   between copies; payload-free nodes are recycled via free list
+// - MakeSnapshot and Fork are O(1), versions share structure
+// - Iterators walk the tree of their version without copying
+// - Tree shape depends only on the set of keys (priority = hash(key)),
+//   so it is deterministic across runs
+//
+// Merge mutations are applied eagerly if `operators` are provided
+
+class MemoryDatabase : public IDatabase {
+ public:
+  explicit MemoryDatabase(const MergeOperators* operators = nullptr);
+
+  // Data is kept in memory, `directory` is ignored
+  void Open(const std::string& directory) override;
+
+  void Put(const Key& key, const Value& value) override;
+  std::optional<Value> TryGet(const Key& key) const override;
+  void Delete(const Key& key) override;
+  void Merge(const Key& key, const Value& operand) override;
+
+  bool SupportsMerge() const override {
+    return operators_ != nullptr;
+  }
+
+  void Write(WriteBatch batch) override;
+
+  ISnapshotPtr MakeSnapshot() override;
+
+  // O(1) copy of the current state, e.g. for crash points
+  std::unique_ptr<MemoryDatabase> Fork() const;
+
+  size_t Size() const {
+    return size_;
+  }
+
+ private:
+  void Apply(memory::Root& root, Mutation& mut);
+
+ private:
+  const MergeOperators* operators_;
+  memory::Root root_;
+  size_t size_ = 0;
+};
+
+}  // namespace whirl::node::db
@@ -0,0 +1,466 @@
+#include <whirl/node/db/merge.hpp>
+
+#include <wheels/support/assert.hpp>
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+namespace whirl::node::db {
+
+//////////////////////////////////////////////////////////////////////
+
+void MergeOperators::Register(std::string prefix, MergeOperator merge) {
+  operators_.insert_or_assign(std::move(prefix), std::move(merge));
+}
+
+const MergeOperator* MergeOperators::Find(KeyView key) const {
+  // Longest matching prefix
+  for (size_t length = key.size() + 1; length-- > 0;) {
+    auto it = operators_.find(key.substr(0, length));
+    if (it != operators_.end()) {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
+Value ApplyMerges(const MergeOperators& operators, KeyView key,
+                  std::optional<ValueView> existing,
+                  const std::vector<ValueView>& operands) {
+  const auto* merge = operators.Find(key);
+  if (merge == nullptr) {
+    WHEELS_PANIC(fmt::format("Merge operator not found for key '{}'", key));
+  }
+  return (*merge)(key, existing, operands);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Operand keys live in a reserved namespace, separate from user keys:
+// {kOperandPrefix}{escaped key}\0\1{seq: u64 big-endian}
+// Escaping (\0 -> \0\xFF) preserves user key order and makes
+// the \0\1 terminator unambiguous
+
+static const std::string_view kOperandPrefix{"\xFF\xFFmerge:"};
+// First key after the operand namespace
+static const std::string_view kOperandPrefixEnd{"\xFF\xFFmerge;"};
+
+static const std::string_view kTerminator{"\0\1", 2};
+static const size_t kSeqSize = 8;
+
+static bool IsOperandKey(KeyView key) {
+  return key.starts_with(kOperandPrefix);
+}
+
+// Start of the operand group of `key`
+static Key OperandGroupKey(KeyView key) {
+  Key group;
+  group.reserve(kOperandPrefix.size() + key.size() + kTerminator.size() +
+                kSeqSize);
+  group.append(kOperandPrefix);
+  for (char c : key) {
+    group.push_back(c);
+    if (c == '\0') {
+      group.push_back('\xFF');
+    }
+  }
+  group.append(kTerminator);
+  return group;
+}
+
+static Key OperandKey(KeyView key, uint64_t seq) {
+  Key operand_key = OperandGroupKey(key);
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    operand_key.push_back(static_cast<char>((seq >> shift) & 0xFF));
+  }
+  return operand_key;
+}
+
+[[noreturn]] static void CorruptedOperandKey() {
+  WHEELS_PANIC("Malformed merge operand key");
+}
+
+// User key of the operand key
+static Key UserKey(KeyView operand_key) {
+  KeyView escaped = operand_key.substr(kOperandPrefix.size());
+
+  Key key;
+  for (size_t i = 0; i < escaped.size(); ++i) {
+    if (escaped[i] != '\0') {
+      key.push_back(escaped[i]);
+      continue;
+    }
+    if (i + 1 == escaped.size()) {
+      CorruptedOperandKey();
+    }
+    if (escaped[i + 1] == '\1') {
+      if (escaped.size() - i - kTerminator.size() != kSeqSize) {
+        CorruptedOperandKey();
+      }
+      return key;
+    }
+    key.push_back('\0');
+    ++i;  // Skip escape
+  }
+  CorruptedOperandKey();
+}
+
+static uint64_t OperandSeq(KeyView operand_key) {
+  uint64_t seq = 0;
+  for (size_t i = operand_key.size() - kSeqSize; i < operand_key.size();
+       ++i) {
+    seq = (seq << 8) | static_cast<uint8_t>(operand_key[i]);
+  }
+  return seq;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Merges two ordered streams over the same snapshot:
+// user keys (operand namespace skipped) and operand groups
+// Presents each key with its operands as a single merged entry
+
+class MergingIterator : public IIterator {
+ public:
+  MergingIterator(ISnapshot& snapshot, const MergeOperators* operators)
+      : values_(snapshot.MakeIterator()),
+        operands_(snapshot.MakeIterator()),
+        operators_(operators) {
+  }
+
+  bool Valid() const override {
+    return key_.has_value();
+  }
+
+  KeyView Key() const override {
+    return *key_;
+  }
+
+  ValueView Value() const override {
+    return value_;
+  }
+
+  void Seek(const db::Key& target) override {
+    values_->Seek(target);
+    SkipOperandsForward();
+    operands_->Seek(OperandGroupKey(target));
+    LoadGroup();
+  }
+
+  void SeekToFirst() override {
+    values_->SeekToFirst();
+    SkipOperandsForward();
+    operands_->Seek(db::Key{kOperandPrefix});
+    LoadGroup();
+  }
+
+  void SeekToLast() override {
+    values_->SeekToLast();
+    SkipOperandsBackward();
+
+    operands_->Seek(db::Key{kOperandPrefixEnd});
+    if (operands_->Valid()) {
+      operands_->Prev();
+    } else {
+      operands_->SeekToLast();
+    }
+
+    SeekToMax();
+  }
+
+  void Next() override {
+    // Both streams are already at the next group
+    LoadGroup();
+  }
+
+  void Prev() override {
+    db::Key current = std::move(*key_);
+
+    values_->Seek(current);
+    if (values_->Valid()) {
+      values_->Prev();
+    } else {
+      values_->SeekToLast();
+    }
+    SkipOperandsBackward();
+
+    operands_->Seek(OperandGroupKey(current));
+    if (operands_->Valid()) {
+      operands_->Prev();
+    } else {
+      operands_->SeekToLast();
+    }
+
+    SeekToMax();
+  }
+
+ private:
+  bool ValuesValid() const {
+    return values_->Valid();
+  }
+
+  bool OperandsValid() const {
+    return operands_->Valid() && IsOperandKey(operands_->Key());
+  }
+
+  void SkipOperandsForward() {
+    if (values_->Valid() && IsOperandKey(values_->Key())) {
+      values_->Seek(db::Key{kOperandPrefixEnd});
+    }
+  }
+
+  void SkipOperandsBackward() {
+    if (values_->Valid() && IsOperandKey(values_->Key())) {
+      values_->Seek(db::Key{kOperandPrefix});
+      if (values_->Valid()) {
+        values_->Prev();
+      } else {
+        values_->SeekToLast();
+      }
+    }
+  }
+
+  // Streams are positioned at the last entries <= some key,
+  // repositions at the start of the greatest group
+  void SeekToMax() {
+    std::optional<db::Key> last;
+    if (ValuesValid()) {
+      last.emplace(values_->Key());
+    }
+    if (OperandsValid()) {
+      auto key = UserKey(operands_->Key());
+      if (!last.has_value() || key > *last) {
+        last = std::move(key);
+      }
+    }
+
+    if (last.has_value()) {
+      Seek(*last);
+    } else {
+      key_.reset();
+    }
+  }
+
+  // Streams at the start of the next group or exhausted
+  // Leaves them at the start of the following group
+  void LoadGroup() {
+    key_.reset();
+
+    std::optional<db::Key> operand_key;
+    if (OperandsValid()) {
+      operand_key = UserKey(operands_->Key());
+    }
+
+    db::Key key;
+    if (ValuesValid() &&
+        (!operand_key.has_value() || values_->Key() <= *operand_key)) {
+      key = db::Key{values_->Key()};
+    } else if (operand_key.has_value()) {
+      key = std::move(*operand_key);
+    } else {
+      return;  // Exhausted
+    }
+
+    std::optional<db::Value> existing;
+    if (ValuesValid() && values_->Key() == key) {
+      existing.emplace(values_->Value());
+      values_->Next();
+      SkipOperandsForward();
+    }
+
+    std::vector<db::Value> operands;
+    for (; OperandsValid() && UserKey(operands_->Key()) == key;
+         operands_->Next()) {
+      operands.emplace_back(operands_->Value());
+    }
+
+    if (operands.empty()) {
+      value_ = std::move(*existing);
+    } else {
+      std::vector<ValueView> views{operands.begin(), operands.end()};
+      value_ = ApplyMerges(*operators_, key, existing, views);
+    }
+    key_ = std::move(key);
+  }
+
+ private:
+  IIteratorPtr values_;
+  IIteratorPtr operands_;
+  const MergeOperators* operators_;
+
+  std::optional<db::Key> key_;
+  db::Value value_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class MergingSnapshot : public ISnapshot {
+ public:
+  MergingSnapshot(ISnapshotPtr snapshot, const MergeOperators* operators)
+      : snapshot_(std::move(snapshot)), operators_(operators) {
+  }
+
+  std::optional<Value> TryGet(const Key& key) const override {
+    MergingIterator merging{*snapshot_, operators_};
+    merging.Seek(key);
+    if (merging.Valid() && merging.Key() == key) {
+      return Value{merging.Value()};
+    }
+    return std::nullopt;
+  }
+
+  IIteratorPtr MakeIterator() override {
+    return std::make_shared<MergingIterator>(*snapshot_, operators_);
+  }
+
+ private:
+  ISnapshotPtr snapshot_;
+  const MergeOperators* operators_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+MergingDatabase::MergingDatabase(IDatabase* db,
+                                 const MergeOperators* operators,
+                                 MergeParams params)
+    : db_(db),
+      operators_(operators),
+      params_(params) {
+}
+
+void MergingDatabase::Open(const std::string& directory) {
+  db_->Open(directory);
+
+  pending_.clear();
+
+  auto it = db_->MakeSnapshot()->MakeIterator();
+  for (it->Seek(Key{kOperandPrefix}); it->Valid() && IsOperandKey(it->Key());
+       it->Next()) {
+    KeyView key = it->Key();
+    pending_[UserKey(key)].push_back({Key{key}, Value{it->Value()}});
+    next_seq_ = std::max(next_seq_, OperandSeq(key) + 1);
+  }
+}
+
+void MergingDatabase::Put(const Key& key, const Value& value) {
+  WriteBatch batch;
+  batch.Put(key, value);
+  Write(std::move(batch));
+}
+
+void MergingDatabase::Delete(const Key& key) {
+  WriteBatch batch;
+  batch.Delete(key);
+  Write(std::move(batch));
+}
+
+void MergingDatabase::Merge(const Key& key, const Value& operand) {
+  WriteBatch batch;
+  batch.Merge(key, operand);
+  Write(std::move(batch));
+}
+
+void MergingDatabase::Write(WriteBatch batch) {
+  for (const auto& mut : batch.muts) {
+    WHEELS_VERIFY(!IsOperandKey(mut.key),
+                  "Key in reserved merge operand namespace");
+  }
+
+  // Fast path
+  if (pending_.empty() && batch.muts.size() == 1 &&
+      batch.muts[0].type != MutationType::Merge) {
+    db_->Write(std::move(batch));
+    return;
+  }
+
+  WriteBatch translated;
+  std::vector<Key> merged;
+
+  for (auto& mut : batch.muts) {
+    switch (mut.type) {
+      case MutationType::Merge: {
+        auto operand_key = OperandKey(mut.key, next_seq_++);
+        pending_[mut.key].push_back({operand_key, *mut.value});
+        translated.Put(std::move(operand_key), std::move(*mut.value));
+        merged.push_back(std::move(mut.key));
+        break;
+      }
+
+      default: {
+        // New value overrides pending operands
+        if (auto it = pending_.find(mut.key); it != pending_.end()) {
+          for (auto& operand : it->second) {
+            translated.Delete(std::move(operand.key));
+          }
+          pending_.erase(it);
+        }
+        translated.muts.push_back(std::move(mut));
+        break;
+      }
+    }
+  }
+
+  db_->Write(std::move(translated));
+
+  for (const auto& key : merged) {
+    auto it = pending_.find(key);
+    if (it != pending_.end() && it->second.size() >= params_.max_operands) {
+      Compact(key);
+    }
+  }
+}
+
+std::optional<Value> MergingDatabase::TryGet(const Key& key) const {
+  auto existing = db_->TryGet(key);
+
+  auto it = pending_.find(key);
+  if (it == pending_.end()) {
+    return existing;
+  }
+
+  std::vector<ValueView> operands;
+  operands.reserve(it->second.size());
+  for (const auto& operand : it->second) {
+    operands.push_back(operand.value);
+  }
+
+  return ApplyMerges(*operators_, key, existing, operands);
+}
+
+ISnapshotPtr MergingDatabase::MakeSnapshot() {
+  return std::make_shared<MergingSnapshot>(db_->MakeSnapshot(), operators_);
+}
+
+void MergingDatabase::Compact(const Key& key) {
+  auto it = pending_.find(key);
+  if (it == pending_.end()) {
+    return;
+  }
+
+  auto value = TryGet(key);
+
+  // Put drops operands in the same batch
+  WriteBatch batch;
+  batch.Put(key, std::move(*value));
+  Write(std::move(batch));
+}
+
+void MergingDatabase::CompactAll() {
+  std::vector<Key> keys;
+  for (const auto& [key, _] : pending_) {
+    keys.push_back(key);
+  }
+  for (const auto& key : keys) {
+    Compact(key);
+  }
+}
+
+size_t MergingDatabase::PendingOperands() const {
+  size_t count = 0;
+  for (const auto& [_, operands] : pending_) {
+    count += operands.size();
+  }
+  return count;
+}
+
+}  // namespace whirl::node::db
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <whirl/node/db/database.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace whirl::node::db {
+
+// ~ RocksDB merge operator
+// Combines existing value (if any) with operands in write order
+using MergeOperator = std::function<Value(
+    KeyView key, std::optional<ValueView> existing,
+    const std::vector<ValueView>& operands)>;
+
+// Merge operators by key prefix (namespace), longest prefix wins
+
+class MergeOperators {
+ public:
+  void Register(std::string prefix, MergeOperator merge);
+
+  // nullptr if not found
+  const MergeOperator* Find(KeyView key) const;
+
+ private:
+  std::map<std::string, MergeOperator, std::less<>> operators_;
+};
+
+// Panics if no operator registered for key
+Value ApplyMerges(const MergeOperators& operators, KeyView key,
+                  std::optional<ValueView> existing,
+                  const std::vector<ValueView>& operands);
+
+//////////////////////////////////////////////////////////////////////
+
+struct MergeParams {
+  // Operands of a key are folded into its value after this many merges
+  size_t max_operands = 16;
+};
+
+// Resolves Merge mutations on top of a database without merge support
+//
+// Merge is a blind write of an operand key to a reserved namespace
+// (keys starting with "\xFF\xFFmerge:", not allowed for user keys),
+// operands are applied lazily on reads (TryGet, snapshots, iterators)
+// and folded into the base value on compaction
+// Pending operands of the live database are also kept in memory
+// (bounded by max_operands) so point reads do not need iteration,
+// snapshots read operands from the underlying snapshot
+
+class MergingDatabase : public IDatabase {
+  struct Operand {
+    Key key;  // Operand key
+    Value value;
+  };
+
+  using Pending = std::map<Key, std::vector<Operand>>;
+
+ public:
+  MergingDatabase(IDatabase* db, const MergeOperators* operators,
+                  MergeParams params = {});
+
+  // Recovers pending operands
+  void Open(const std::string& directory) override;
+
+  void Put(const Key& key, const Value& value) override;
+  std::optional<Value> TryGet(const Key& key) const override;
+  void Delete(const Key& key) override;
+  void Merge(const Key& key, const Value& operand) override;
+
+  bool SupportsMerge() const override {
+    return true;
+  }
+
+  void Write(WriteBatch batch) override;
+
+  ISnapshotPtr MakeSnapshot() override;
+
+  // Folds operands of the key into its value
+  void Compact(const Key& key);
+  void CompactAll();
+
+  size_t PendingOperands() const;
+
+ private:
+  IDatabase* db_;
+  const MergeOperators* operators_;
+  const MergeParams params_;
+
+  Pending pending_;
+  uint64_t next_seq_ = 0;
+};
+
+}  // namespace whirl::node::db
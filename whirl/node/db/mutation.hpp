@@ -16,7 +16,9 @@ struct MutationType {
 
   enum _ {
     Put = 0,  // Do not format
-    Delete = 1
+    Delete = 1,
+    // Operand for registered merge operator, see db/merge.hpp
+    Merge = 2
   };
 };
 
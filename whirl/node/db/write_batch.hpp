@@ -16,6 +16,20 @@ struct WriteBatch {
   void Delete(Key key) {
     muts.push_back({MutationType::Delete, std::move(key), std::nullopt});
   }
+
+  // Requires merge-capable database, see IDatabase::SupportsMerge
+  void Merge(Key key, Value operand) {
+    muts.push_back({MutationType::Merge, std::move(key), std::move(operand)});
+  }
+
+  bool HasMerges() const {
+    for (const auto& mut : muts) {
+      if (mut.type == MutationType::Merge) {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
 }  // namespace whirl::node::db
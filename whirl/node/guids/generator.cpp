@@ -0,0 +1,30 @@
+#include <whirl/node/guids/generator.hpp>
+
+namespace whirl::node::guids {
+
+static const uint64_t kCounterBits = 48;
+
+// SplitMix64 finalizer
+static uint64_t Mix(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  return x ^ (x >> 31);
+}
+
+uint64_t Generator::MakeNodeId(const std::string& host, uint64_t boot_nonce) {
+  // FNV-1a: stable across processes, unlike std::hash
+  uint64_t digest = 0xcbf29ce484222325;
+  for (char c : host) {
+    digest = (digest ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+  }
+  return Mix(digest ^ Mix(boot_nonce));
+}
+
+Guid Generator::Generate() {
+  uint64_t count = counter_.fetch_add(1, std::memory_order_relaxed);
+  uint64_t lo = (static_cast<uint64_t>(shard_) << kCounterBits) |
+                (count & ((uint64_t{1} << kCounterBits) - 1));
+  return {node_id_, lo};
+}
+
+}  // namespace whirl::node::guids
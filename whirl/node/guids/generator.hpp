@@ -0,0 +1,40 @@
+#pragma once
+
+#include <whirl/node/guids/service.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace whirl::node::guids {
+
+// Lock-free generator: node identity + shard + counter
+// hi = node id, lo = shard (16 bits) | counter (48 bits)
+//
+// Values depend only on the generator and the order of calls,
+// never on thread identity, so simulations stay reproducible
+// Real engines with per-core generation create one generator per core
+// with distinct shards
+
+class Generator : public IGuidGenerator {
+ public:
+  // `node_id` must be unique across the cluster and across node restarts,
+  // see MakeNodeId
+  explicit Generator(uint64_t node_id, uint16_t shard = 0)
+      : node_id_(node_id), shard_(shard) {
+  }
+
+  Guid Generate() override;
+
+  // Mixes host name with a random boot nonce
+  static uint64_t MakeNodeId(const std::string& host, uint64_t boot_nonce);
+
+ private:
+  const uint64_t node_id_;
+  const uint16_t shard_;
+  // Separate cache line: generators of different cores do not
+  // share it
+  alignas(64) std::atomic<uint64_t> counter_{0};
+};
+
+}  // namespace whirl::node::guids
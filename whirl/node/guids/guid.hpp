@@ -0,0 +1,73 @@
+#pragma once
+
+#include <muesli/serializable.hpp>
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace whirl::node::guids {
+
+// 128-bit globally unique identifier
+// Rendered as string only on demand
+
+struct Guid {
+  uint64_t hi = 0;
+  uint64_t lo = 0;
+
+  // 32 hex digits
+  std::string ToString() const {
+    return fmt::format("{:016x}{:016x}", hi, lo);
+  }
+
+  MUESLI_SERIALIZABLE(hi, lo)
+};
+
+inline bool operator==(const Guid& lhs, const Guid& rhs) {
+  return lhs.hi == rhs.hi && lhs.lo == rhs.lo;
+}
+
+inline bool operator!=(const Guid& lhs, const Guid& rhs) {
+  return !(lhs == rhs);
+}
+
+inline bool operator<(const Guid& lhs, const Guid& rhs) {
+  return lhs.hi < rhs.hi || (lhs.hi == rhs.hi && lhs.lo < rhs.lo);
+}
+
+inline std::ostream& operator<<(std::ostream& out, const Guid& guid) {
+  out << guid.ToString();
+  return out;
+}
+
+}  // namespace whirl::node::guids
+
+//////////////////////////////////////////////////////////////////////
+
+namespace std {
+
+template <>
+struct hash<whirl::node::guids::Guid> {
+  size_t operator()(const whirl::node::guids::Guid& guid) const {
+    // Halves are already well mixed by the generator
+    return std::hash<uint64_t>{}(guid.hi ^ (guid.lo * 0x9e3779b97f4a7c15));
+  }
+};
+
+}  // namespace std
+
+//////////////////////////////////////////////////////////////////////
+
+// fmtlib support
+
+template <>
+struct fmt::formatter<whirl::node::guids::Guid>
+    : fmt::formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(const whirl::node::guids::Guid& guid, FormatContext& ctx) {
+    return fmt::format_to(ctx.out(), "{:016x}{:016x}", guid.hi, guid.lo);
+  }
+};
@@ -1,15 +1,15 @@
 #pragma once
 
-#include <string>
+#include <whirl/node/guids/guid.hpp>
 
 namespace whirl::node::guids {
 
-// Generates globally unique strings
+// Generates globally unique identifiers
 
 struct IGuidGenerator {
   virtual ~IGuidGenerator() = default;
 
-  virtual std::string Generate() = 0;
+  virtual Guid Generate() = 0;
 };
 
 }  // namespace whirl::node::guids
@@ -0,0 +1,59 @@
+#include <whirl/node/log/crc32.hpp>
+
+#include <array>
+
+namespace whirl::node::log {
+
+using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+static constexpr Tables MakeTables() {
+  Tables tables{};
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0);
+    }
+    tables[0][i] = crc;
+  }
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (size_t t = 1; t < 8; ++t) {
+      uint32_t prev = tables[t - 1][i];
+      tables[t][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+    }
+  }
+
+  return tables;
+}
+
+static constexpr Tables kTables = MakeTables();
+
+static uint32_t Load32(const uint8_t* p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) |
+         (uint32_t(p[3]) << 24);
+}
+
+uint32_t Crc32(const void* data, size_t size, uint32_t crc) {
+  auto* p = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+
+  while (size >= 8) {
+    uint32_t lo = Load32(p) ^ crc;
+    uint32_t hi = Load32(p + 4);
+    crc = kTables[7][lo & 0xFF] ^ kTables[6][(lo >> 8) & 0xFF] ^
+          kTables[5][(lo >> 16) & 0xFF] ^ kTables[4][lo >> 24] ^
+          kTables[3][hi & 0xFF] ^ kTables[2][(hi >> 8) & 0xFF] ^
+          kTables[1][(hi >> 16) & 0xFF] ^ kTables[0][hi >> 24];
+    p += 8;
+    size -= 8;
+  }
+
+  while (size-- > 0) {
+    crc = (crc >> 8) ^ kTables[0][(crc ^ *p++) & 0xFF];
+  }
+
+  return ~crc;
+}
+
+}  // namespace whirl::node::log
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace whirl::node::log {
+
+// CRC-32 (IEEE 802.3), slicing-by-8
+
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
+
+inline uint32_t Crc32(std::string_view data) {
+  return Crc32(data.data(), data.size());
+}
+
+}  // namespace whirl::node::log
@@ -0,0 +1,289 @@
+#include <whirl/node/log/log.hpp>
+
+#include <wheels/support/assert.hpp>
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <charconv>
+
+namespace whirl::node::log {
+
+//////////////////////////////////////////////////////////////////////
+
+Reader::Reader(persist::fs::IFileSystem* fs,
+               std::vector<SegmentInfo> segments, uint64_t from,
+               uint64_t last)
+    : fs_(fs),
+      segments_(std::move(segments)),
+      next_index_(from),
+      last_index_(last) {
+  // Skip segments entirely before `from`
+  while (next_segment_ + 1 < segments_.size() &&
+         segments_[next_segment_ + 1].first_index <= from) {
+    ++next_segment_;
+  }
+}
+
+bool Reader::OpenNextSegment() {
+  if (next_segment_ == segments_.size()) {
+    return false;
+  }
+
+  const auto& info = segments_[next_segment_++];
+  segment_ = std::make_unique<SegmentReader>(fs_, info.path);
+
+  WHEELS_VERIFY(segment_->FirstIndex() == info.first_index,
+                fmt::format("Log segment {} has invalid header", info.path));
+  // segment_index_ == 0: no segments read yet
+  WHEELS_VERIFY(segment_index_ == 0 || segment_index_ == info.first_index,
+                fmt::format("Log segment {} starts at {}, expected {}",
+                            info.path, info.first_index, segment_index_));
+
+  segment_index_ = info.first_index;
+  return true;
+}
+
+std::optional<std::string_view> Reader::Next() {
+  while (next_index_ <= last_index_) {
+    if (!segment_ && !OpenNextSegment()) {
+      WHEELS_PANIC(fmt::format("Log entries [{}, {}] are missing",
+                               next_index_, last_index_));
+    }
+
+    auto record = segment_->Next();
+
+    if (!record.has_value()) {
+      // End of segment
+      segment_.reset();
+      continue;
+    }
+
+    uint64_t index = segment_index_++;
+    if (index < next_index_) {
+      continue;  // Before starting point
+    }
+
+    ++next_index_;
+    return record;
+  }
+
+  return std::nullopt;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+SegmentedLog::SegmentedLog(persist::fs::IFileSystem* fs, Params params)
+    : fs_(fs), params_(std::move(params)) {
+}
+
+SegmentedLog::~SegmentedLog() {
+  CloseTail();
+}
+
+std::string SegmentedLog::SegmentPrefix() const {
+  return fmt::format("{}/segment-", params_.dir);
+}
+
+std::string SegmentedLog::SegmentPath(uint64_t seq) const {
+  return fmt::format("{}{:020}", SegmentPrefix(), seq);
+}
+
+std::vector<uint64_t> SegmentedLog::ListSegments() const {
+  auto prefix = SegmentPrefix();
+
+  std::vector<uint64_t> seqs;
+  for (const auto& file : fs_->ListFiles(prefix)) {
+    std::string_view path{file};
+    auto name = path.substr(prefix.size());
+
+    // Skip foreign files, e.g. segment-0001.tmp
+    uint64_t seq;
+    auto [end, ec] =
+        std::from_chars(name.data(), name.data() + name.size(), seq);
+    if (ec != std::errc{} || end != name.data() + name.size()) {
+      continue;
+    }
+    seqs.push_back(seq);
+  }
+  std::sort(seqs.begin(), seqs.end());
+  return seqs;
+}
+
+void SegmentedLog::Open() {
+  bool torn = false;
+  // Files without a valid header, only allowed after the last segment
+  std::vector<uint64_t> garbage;
+
+  for (uint64_t seq : ListSegments()) {
+    auto path = SegmentPath(seq);
+
+    SegmentReader reader{fs_, path};
+
+    if (!reader.FirstIndex().has_value()) {
+      if (reader.IsEmpty() && !spare_.has_value()) {
+        spare_ = seq;  // Pre-created segment
+      } else {
+        // Torn header: header is synced together with the first
+        // records, so the file holds no durable entries
+        garbage.push_back(seq);
+      }
+      continue;
+    }
+
+    WHEELS_VERIFY(
+        !spare_.has_value() && garbage.empty(),
+        fmt::format("Log segment {} follows an invalid segment", path));
+
+    uint64_t first = *reader.FirstIndex();
+
+    // Torn tail of a segment is never acknowledged: the next append
+    // starts a new segment at the first lost index. Any gap means that
+    // acknowledged entries are lost (e.g. corrupted mid-log record)
+    WHEELS_VERIFY(segments_.empty() || first == next_index_,
+                  fmt::format("Log segment {} starts at {}, expected {}: "
+                              "entries are lost",
+                              path, first, next_index_));
+
+    uint64_t count = 0;
+    while (reader.Next().has_value()) {
+      ++count;
+    }
+
+    if (segments_.empty()) {
+      first_index_ = first;
+    }
+    next_index_ = first + count;
+    torn = reader.Corrupted();
+
+    segments_.push_back({seq, path, first, reader.ValidBytes()});
+  }
+
+  for (uint64_t seq : garbage) {
+    fs_->Delete(fs_->MakePath(SegmentPath(seq)));
+  }
+
+  if (!segments_.empty() && !torn) {
+    // Continue appending to the last segment
+    const auto& last = segments_.back();
+    tail_ = fs_->Open(fs_->MakePath(last.path), persist::fs::FileMode::Append);
+  }
+  // Otherwise: empty log or garbage after the last valid record,
+  // the first append starts a new segment
+}
+
+void SegmentedLog::CreateSpare(uint64_t seq) {
+  fs_->Create(fs_->MakePath(SegmentPath(seq)));
+  spare_ = seq;
+}
+
+void SegmentedLog::CloseTail() {
+  if (tail_.has_value()) {
+    fs_->Close(*tail_);
+    tail_.reset();
+  }
+}
+
+void SegmentedLog::Roll() {
+  CloseTail();
+
+  uint64_t seq;
+  if (spare_.has_value()) {
+    seq = *spare_;
+    spare_.reset();
+  } else {
+    seq = segments_.empty() ? 0 : segments_.back().seq + 1;
+    fs_->Create(fs_->MakePath(SegmentPath(seq)));
+  }
+
+  auto path = SegmentPath(seq);
+  tail_ = fs_->Open(fs_->MakePath(path), persist::fs::FileMode::Append);
+
+  segments_.push_back({seq, path, next_index_, 0});
+
+  // Pay for file creation before the next roll
+  CreateSpare(seq + 1);
+}
+
+void SegmentedLog::Write(const std::string& buffer, size_t count) {
+  if (!tail_.has_value() || segments_.back().size >= params_.segment_size) {
+    Roll();
+
+    // Single write + sync for header and first records: recovered
+    // segment either has no header (zero-length / torn) or has records
+    std::string chunk;
+    chunk.reserve(kSegmentHeaderSize + buffer.size());
+    EncodeSegmentHeader(chunk, next_index_);
+    chunk.append(buffer);
+    WriteTail(chunk);
+  } else {
+    WriteTail(buffer);
+  }
+
+  next_index_ += count;
+}
+
+void SegmentedLog::WriteTail(const std::string& data) {
+  fs_->Append(*tail_, wheels::ConstMemView{data.data(), data.size()});
+  fs_->Sync(*tail_);
+  segments_.back().size += data.size();
+}
+
+uint64_t SegmentedLog::Append(std::string_view entry) {
+  std::string buffer;
+  buffer.reserve(kRecordHeaderSize + entry.size());
+  EncodeRecord(buffer, entry);
+
+  Write(buffer, 1);
+  return LastIndex();
+}
+
+uint64_t SegmentedLog::Append(const std::vector<std::string>& entries) {
+  if (entries.empty()) {
+    return LastIndex();
+  }
+
+  size_t total = 0;
+  for (const auto& entry : entries) {
+    total += kRecordHeaderSize + entry.size();
+  }
+
+  std::string buffer;
+  buffer.reserve(total);
+  for (const auto& entry : entries) {
+    EncodeRecord(buffer, entry);
+  }
+
+  Write(buffer, entries.size());
+  return LastIndex();
+}
+
+void SegmentedLog::TruncatePrefix(uint64_t index) {
+  WHEELS_VERIFY(index <= next_index_, "Cannot truncate past the end of log");
+
+  if (index <= first_index_) {
+    return;
+  }
+  first_index_ = index;
+
+  // Segment is garbage if the next one starts at or before `index`,
+  // tail segment is never deleted
+  while (segments_.size() > 1 && segments_[1].first_index <= index) {
+    fs_->Delete(fs_->MakePath(segments_.front().path));
+    segments_.pop_front();
+  }
+}
+
+Reader SegmentedLog::ReadFrom(uint64_t index) const {
+  std::vector<SegmentInfo> segments;
+  segments.reserve(segments_.size());
+  for (const auto& segment : segments_) {
+    segments.push_back({segment.path, segment.first_index});
+  }
+
+  return Reader{fs_, std::move(segments), std::max(index, first_index_),
+                LastIndex()};
+}
+
+}  // namespace whirl::node::log
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <whirl/node/log/segment.hpp>
+
+#include <persist/fs/fs.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace whirl::node::log {
+
+// Indices start from 1
+
+//////////////////////////////////////////////////////////////////////
+
+struct SegmentInfo {
+  std::string path;
+  uint64_t first_index;
+};
+
+// Sequential reader over log segments
+// Observes entries appended before construction
+
+class Reader {
+ public:
+  Reader(persist::fs::IFileSystem* fs, std::vector<SegmentInfo> segments,
+         uint64_t from, uint64_t last);
+
+  // Entry view, valid until the next call
+  std::optional<std::string_view> Next();
+
+  // Index of the entry to be returned by Next
+  uint64_t NextIndex() const {
+    return next_index_;
+  }
+
+ private:
+  bool OpenNextSegment();
+
+ private:
+  persist::fs::IFileSystem* fs_;
+  std::vector<SegmentInfo> segments_;
+  size_t next_segment_ = 0;
+  std::unique_ptr<SegmentReader> segment_;
+  // Index of the next record in current segment
+  uint64_t segment_index_ = 0;
+  uint64_t next_index_;
+  uint64_t last_index_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Durable append-only log stored as a sequence of segment files
+// {dir}/segment-{seq}, each segment starts with the index of its first entry
+//
+// - Batched appends: one write and one Sync per batch
+// - Next segment file is created in advance
+// - Records are checksummed, torn tail is detected on recovery
+// - Recovery (Open) and reads fail on gaps between segments,
+//   i.e. on lost or corrupted acknowledged entries
+// - Prefix truncation deletes whole segments
+//
+// Usage:
+//
+// log::SegmentedLog wal{rt::FileSystem(), {.dir = "/wal"}};
+// wal.Open();
+// wal.Append({entry1, entry2});
+// auto reader = wal.ReadFrom(wal.FirstIndex());
+// while (auto entry = reader.Next()) { ... }
+
+class SegmentedLog {
+ public:
+  struct Params {
+    std::string dir;
+    // Segment is rolled after reaching this size
+    size_t segment_size = 8 * 1024 * 1024;
+  };
+
+  SegmentedLog(persist::fs::IFileSystem* fs, Params params);
+  ~SegmentedLog();
+
+  // Non-copyable
+  SegmentedLog(const SegmentedLog&) = delete;
+  SegmentedLog& operator=(const SegmentedLog&) = delete;
+
+  // Recovers from existing segments
+  // Must be called before any other method
+  void Open();
+
+  // Returns index of the appended entry
+  uint64_t Append(std::string_view entry);
+
+  // Durable after return, returns index of the last appended entry
+  uint64_t Append(const std::vector<std::string>& entries);
+
+  uint64_t FirstIndex() const {
+    return first_index_;
+  }
+
+  // FirstIndex() - 1 for empty log
+  uint64_t LastIndex() const {
+    return next_index_ - 1;
+  }
+
+  bool IsEmpty() const {
+    return next_index_ == first_index_;
+  }
+
+  size_t SegmentCount() const {
+    return segments_.size();
+  }
+
+  // Discards entries with indices < index
+  // Space is reclaimed at segment granularity: entries from partially
+  // truncated segment are hidden, but can reappear after recovery
+  void TruncatePrefix(uint64_t index);
+
+  Reader ReadFrom(uint64_t index) const;
+
+ private:
+  struct Segment {
+    uint64_t seq;
+    std::string path;
+    uint64_t first_index;
+    size_t size;
+  };
+
+  std::string SegmentPath(uint64_t seq) const;
+  std::string SegmentPrefix() const;
+
+  std::vector<uint64_t> ListSegments() const;
+
+  // Starts new tail segment at next_index_
+  // Header is written by the caller together with the first records
+  void Roll();
+  void CreateSpare(uint64_t seq);
+  void CloseTail();
+
+  void Write(const std::string& buffer, size_t count);
+  void WriteTail(const std::string& data);
+
+ private:
+  persist::fs::IFileSystem* fs_;
+  const Params params_;
+
+  std::deque<Segment> segments_;
+  std::optional<persist::fs::Fd> tail_;
+  // Pre-created zero-length segment file
+  std::optional<uint64_t> spare_;
+
+  uint64_t first_index_ = 1;
+  uint64_t next_index_ = 1;
+};
+
+}  // namespace whirl::node::log
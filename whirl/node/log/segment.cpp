@@ -0,0 +1,129 @@
+#include <whirl/node/log/segment.hpp>
+
+#include <whirl/node/log/crc32.hpp>
+
+namespace whirl::node::log {
+
+//////////////////////////////////////////////////////////////////////
+
+static void Put32(std::string& buffer, uint32_t value) {
+  for (size_t i = 0; i < 4; ++i) {
+    buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+static void Put64(std::string& buffer, uint64_t value) {
+  Put32(buffer, static_cast<uint32_t>(value));
+  Put32(buffer, static_cast<uint32_t>(value >> 32));
+}
+
+static uint32_t Get32(const char* data) {
+  auto* p = reinterpret_cast<const uint8_t*>(data);
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) |
+         (uint32_t(p[3]) << 24);
+}
+
+static uint64_t Get64(const char* data) {
+  return uint64_t(Get32(data)) | (uint64_t(Get32(data + 4)) << 32);
+}
+
+void EncodeSegmentHeader(std::string& buffer, uint64_t first_index) {
+  Put32(buffer, kSegmentMagic);
+  Put64(buffer, first_index);
+}
+
+void EncodeRecord(std::string& buffer, std::string_view payload) {
+  Put32(buffer, static_cast<uint32_t>(payload.size()));
+  Put32(buffer, Crc32(payload));
+  buffer.append(payload);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+SegmentReader::SegmentReader(persist::fs::IFileSystem* fs,
+                             const std::string& path, size_t chunk_size)
+    : fs_(fs),
+      fd_(fs->Open(fs->MakePath(path), persist::fs::FileMode::ReadOnly)),
+      chunk_size_(chunk_size) {
+  if (!Fill(kSegmentHeaderSize)) {
+    // Empty or torn header
+    empty_ = buffer_.empty();
+    corrupted_ = !empty_;
+    return;
+  }
+
+  const char* header = buffer_.data() + pos_;
+  if (Get32(header) != kSegmentMagic) {
+    corrupted_ = true;
+    return;
+  }
+  first_index_ = Get64(header + 4);
+
+  pos_ += kSegmentHeaderSize;
+  valid_bytes_ = kSegmentHeaderSize;
+}
+
+SegmentReader::~SegmentReader() {
+  fs_->Close(fd_);
+}
+
+bool SegmentReader::Fill(size_t bytes) {
+  // Compact consumed prefix
+  if (pos_ > 0) {
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+  }
+
+  while (buffer_.size() < bytes && !eof_) {
+    size_t size = buffer_.size();
+    size_t want = std::max(chunk_size_, bytes - size);
+    buffer_.resize(size + want);
+
+    size_t read =
+        fs_->Read(fd_, wheels::MutableMemView{buffer_.data() + size, want});
+    buffer_.resize(size + read);
+
+    if (read == 0) {
+      eof_ = true;
+    }
+  }
+
+  return buffer_.size() >= bytes;
+}
+
+std::optional<std::string_view> SegmentReader::Next() {
+  if (!first_index_.has_value() || corrupted_) {
+    return std::nullopt;
+  }
+
+  if (buffer_.size() - pos_ < kRecordHeaderSize) {
+    if (!Fill(kRecordHeaderSize)) {
+      // Clean end of segment or partial header
+      corrupted_ = buffer_.size() > pos_;
+      return std::nullopt;
+    }
+  }
+
+  uint32_t size = Get32(buffer_.data() + pos_);
+  uint32_t crc = Get32(buffer_.data() + pos_ + 4);
+
+  if (buffer_.size() - pos_ < kRecordHeaderSize + size) {
+    if (!Fill(kRecordHeaderSize + size)) {
+      corrupted_ = true;
+      return std::nullopt;
+    }
+  }
+
+  std::string_view payload{buffer_.data() + pos_ + kRecordHeaderSize, size};
+  if (Crc32(payload) != crc) {
+    corrupted_ = true;
+    return std::nullopt;
+  }
+
+  pos_ += kRecordHeaderSize + size;
+  valid_bytes_ += kRecordHeaderSize + size;
+
+  return payload;
+}
+
+}  // namespace whirl::node::log
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <persist/fs/fs.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace whirl::node::log {
+
+// Segment file layout:
+// [magic: u32][first index: u64]
+// [size: u32][crc32(payload): u32][payload] ...
+//
+// Integers are little-endian
+
+static const uint32_t kSegmentMagic = 0x4C574857;  // "WHWL"
+static const size_t kSegmentHeaderSize = 12;
+static const size_t kRecordHeaderSize = 8;
+
+void EncodeSegmentHeader(std::string& buffer, uint64_t first_index);
+void EncodeRecord(std::string& buffer, std::string_view payload);
+
+//////////////////////////////////////////////////////////////////////
+
+// Sequential reader of a single segment file
+// Reads large chunks, records are returned as views into the buffer
+
+class SegmentReader {
+ public:
+  SegmentReader(persist::fs::IFileSystem* fs, const std::string& path,
+                size_t chunk_size = 64 * 1024);
+  ~SegmentReader();
+
+  // Non-copyable
+  SegmentReader(const SegmentReader&) = delete;
+  SegmentReader& operator=(const SegmentReader&) = delete;
+
+  // std::nullopt for empty (preallocated), torn or foreign files
+  std::optional<uint64_t> FirstIndex() const {
+    return first_index_;
+  }
+
+  // Zero-length file
+  bool IsEmpty() const {
+    return empty_;
+  }
+
+  // Next valid record, valid until the next call
+  // std::nullopt at the end of segment or at the first corrupted record
+  std::optional<std::string_view> Next();
+
+  // Bytes in header and valid records read so far
+  size_t ValidBytes() const {
+    return valid_bytes_;
+  }
+
+  // Trailing bytes do not form a valid record (e.g. torn write)
+  bool Corrupted() const {
+    return corrupted_;
+  }
+
+ private:
+  // Ensures at least `bytes` unread bytes in buffer
+  bool Fill(size_t bytes);
+
+ private:
+  persist::fs::IFileSystem* fs_;
+  persist::fs::Fd fd_;
+  size_t chunk_size_;
+
+  std::string buffer_;
+  size_t pos_ = 0;
+  bool eof_ = false;
+
+  std::optional<uint64_t> first_index_;
+  bool empty_ = false;
+  size_t valid_bytes_ = 0;
+  bool corrupted_ = false;
+};
+
+}  // namespace whirl::node::log
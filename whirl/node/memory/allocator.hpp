@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdlib>
+
+namespace whirl::node::memory {
+
+// Allocations made on behalf of the current node
+
+struct IAllocator {
+  virtual ~IAllocator() = default;
+
+  virtual void* Allocate(size_t size) = 0;
+  virtual void Deallocate(void* ptr, size_t size) = 0;
+};
+
+}  // namespace whirl::node::memory
@@ -0,0 +1,91 @@
+// Routes global operator new / delete to the allocator
+// of the node bound to the current thread
+// Blocks are returned to the allocator they came from, so allocators
+// must stay valid while their blocks are alive: memory::Tracker keeps
+// its allocator alive until the last block is freed
+// Enabled by WHIRL_TRACK_ALLOCATIONS
+
+#if defined(WHIRL_TRACK_ALLOCATIONS)
+
+#include <whirl/runtime/access.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+using whirl::node::memory::IAllocator;
+
+namespace {
+
+// Keeps max_align_t alignment of the user block
+struct alignas(alignof(std::max_align_t)) Header {
+  IAllocator* allocator;
+  size_t size;
+};
+
+// Allocations made by allocators / runtime getters themselves
+// go directly to malloc
+thread_local bool in_hook = false;
+
+class HookGuard {
+ public:
+  HookGuard() {
+    in_hook = true;
+  }
+
+  ~HookGuard() {
+    in_hook = false;
+  }
+};
+
+IAllocator* CurrentAllocator() {
+  if (in_hook) {
+    return nullptr;
+  }
+  HookGuard guard;
+  auto* runtime = whirl::node::TryGetRuntime();
+  return (runtime != nullptr) ? runtime->Allocator() : nullptr;
+}
+
+void* AllocateBlock(IAllocator* allocator, size_t size) {
+  if (allocator == nullptr) {
+    return std::malloc(size);
+  }
+  HookGuard guard;
+  return allocator->Allocate(size);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  IAllocator* allocator = CurrentAllocator();
+
+  size_t block_size = sizeof(Header) + size;
+  void* block = AllocateBlock(allocator, block_size);
+  if (block == nullptr) {
+    throw std::bad_alloc{};
+  }
+
+  auto* header = new (block) Header{allocator, block_size};
+  return header + 1;
+}
+
+void operator delete(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto* header = static_cast<Header*>(ptr) - 1;
+  if (header->allocator == nullptr) {
+    std::free(header);
+  } else {
+    // Memory is returned to the node that allocated it
+    header->allocator->Deallocate(header, header->size);
+  }
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  operator delete(ptr);
+}
+
+#endif
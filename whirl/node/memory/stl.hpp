@@ -0,0 +1,50 @@
+#pragma once
+
+#include <whirl/runtime/access.hpp>
+
+#include <cstdlib>
+
+namespace whirl::node::memory {
+
+// STL allocator attributing memory to the current node
+// Usage: std::vector<LogEntry, memory::NodeAllocator<LogEntry>> log;
+
+template <typename T>
+class NodeAllocator {
+ public:
+  using value_type = T;  // NOLINT
+
+  NodeAllocator() : allocator_(GetRuntime().Allocator()) {
+  }
+
+  template <typename U>
+  NodeAllocator(const NodeAllocator<U>& that) : allocator_(that.Underlying()) {
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    return static_cast<T*>(allocator_->Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) {  // NOLINT
+    allocator_->Deallocate(ptr, n * sizeof(T));
+  }
+
+  IAllocator* Underlying() const {
+    return allocator_;
+  }
+
+  template <typename U>
+  bool operator==(const NodeAllocator<U>& that) const {
+    return allocator_ == that.Underlying();
+  }
+
+  template <typename U>
+  bool operator!=(const NodeAllocator<U>& that) const {
+    return !(*this == that);
+  }
+
+ private:
+  IAllocator* allocator_;
+};
+
+}  // namespace whirl::node::memory
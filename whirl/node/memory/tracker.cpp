@@ -0,0 +1,90 @@
+#include <whirl/node/memory/tracker.hpp>
+
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace whirl::node::memory {
+
+namespace detail {
+
+Account::Account(size_t budget) : budget_(budget) {
+  budget_handler_ = [budget](const MemoryStats& stats) {
+    WHEELS_PANIC(fmt::format("Node memory budget exceeded: {} bytes live, "
+                             "budget = {} bytes",
+                             stats.live_bytes, budget));
+  };
+}
+
+Account* Account::Create(size_t budget) {
+  // Do not use operator new: it may be routed to another node's allocator
+  void* storage = std::malloc(sizeof(Account));
+  if (storage == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return new (storage) Account(budget);
+}
+
+void Account::Detach() {
+  detached_.store(true);
+  ReleaseRef();
+}
+
+void Account::ReleaseRef() {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    this->~Account();
+    std::free(this);
+  }
+}
+
+void* Account::Allocate(size_t size) {
+  // Do not use operator new: it may be routed back here
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+
+  refs_.fetch_add(1, std::memory_order_relaxed);
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  size_t live = live_bytes_.fetch_add(size, std::memory_order_relaxed) + size;
+  UpdatePeak(live);
+
+  if (budget_ > 0 && live > budget_ && !detached_.load()) {
+    budget_handler_(GetStats());
+  }
+
+  return ptr;
+}
+
+void Account::Deallocate(void* ptr, size_t size) {
+  live_bytes_.fetch_sub(size, std::memory_order_relaxed);
+  std::free(ptr);
+  ReleaseRef();
+}
+
+void Account::UpdatePeak(size_t live) {
+  size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+  while (live > peak && !peak_bytes_.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+MemoryStats Account::GetStats() const {
+  return {live_bytes_.load(), peak_bytes_.load(), allocations_.load()};
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+Tracker::Tracker(size_t budget) : account_(detail::Account::Create(budget)) {
+}
+
+Tracker::~Tracker() {
+  account_->Detach();
+}
+
+}  // namespace whirl::node::memory
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <whirl/node/memory/allocator.hpp>
+
+#include <atomic>
+#include <functional>
+
+namespace whirl::node::memory {
+
+struct MemoryStats {
+  size_t live_bytes;
+  size_t peak_bytes;
+  size_t allocations;
+};
+
+// Invoked when live bytes exceed the budget
+using BudgetHandler = std::function<void(const MemoryStats& stats)>;
+
+namespace detail {
+
+// Allocator behind the tracker
+// Reference counted by the tracker and by live blocks, so blocks freed
+// after the tracker is destroyed (e.g. by global operator delete)
+// still have a valid allocator to return to
+
+class Account : public IAllocator {
+ public:
+  static Account* Create(size_t budget);
+
+  // Drops reference of the tracker
+  void Detach();
+
+  void SetBudgetHandler(BudgetHandler handler) {
+    budget_handler_ = std::move(handler);
+  }
+
+  void* Allocate(size_t size) override;
+  void Deallocate(void* ptr, size_t size) override;
+
+  MemoryStats GetStats() const;
+
+  size_t Budget() const {
+    return budget_;
+  }
+
+ private:
+  explicit Account(size_t budget);
+
+  void UpdatePeak(size_t live);
+  void ReleaseRef();
+
+ private:
+  const size_t budget_;
+  BudgetHandler budget_handler_;
+  std::atomic<bool> detached_{false};
+
+  // Tracker + live blocks
+  std::atomic<size_t> refs_{1};
+
+  std::atomic<size_t> live_bytes_{0};
+  std::atomic<size_t> peak_bytes_{0};
+  std::atomic<size_t> allocations_{0};
+};
+
+}  // namespace detail
+
+// Per-node memory accounting on top of malloc
+// Engine creates one tracker per node and exposes Allocator()
+// via IRuntime::Allocator
+// Blocks may outlive the tracker: they are freed without accounting
+
+class Tracker {
+ public:
+  // budget == 0 - unlimited
+  // Exceeding the budget panics by default
+  explicit Tracker(size_t budget = 0);
+  ~Tracker();
+
+  // Non-copyable
+  Tracker(const Tracker&) = delete;
+  Tracker& operator=(const Tracker&) = delete;
+
+  IAllocator* Allocator() {
+    return account_;
+  }
+
+  void SetBudgetHandler(BudgetHandler handler) {
+    account_->SetBudgetHandler(std::move(handler));
+  }
+
+  // Accounting
+
+  MemoryStats GetStats() const {
+    return account_->GetStats();
+  }
+
+  size_t Budget() const {
+    return account_->Budget();
+  }
+
+ private:
+  detail::Account* account_;
+};
+
+}  // namespace whirl::node::memory
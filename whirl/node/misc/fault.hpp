@@ -1,5 +1,9 @@
 #pragma once
 
+#include <whirl/node/time/jiffies.hpp>
+
+#include <cstdint>
+
 namespace whirl {
 
 struct IFaultInjector {
@@ -8,6 +12,15 @@ struct IFaultInjector {
   virtual void ThreadPause() = 0;
   virtual void Reboot() = 0;
   virtual void AdjustWallClock() = 0;
+
+  // Targeted faults for schedule fuzzing
+
+  // Drop all incoming and outgoing messages for `duration`
+  virtual void DropMessages(Jiffies duration) = 0;
+  // Add `delay` to delivery of messages sent during `duration`
+  virtual void DelayMessages(Jiffies delay, Jiffies duration) = 0;
+  // Shift wall clock by `offset` jiffies (negative - backwards)
+  virtual void SkewWallClock(int64_t offset) = 0;
 };
 
 }  // namespace whirl
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace whirl::node::random {
+
+// Unbiased [0, bound) from uniform 64-bit words without division
+// in the common case
+// Lemire, Fast Random Integer Generation in an Interval
+// https://arxiv.org/abs/1805.10941
+
+// `next_word` - () -> uint64_t, called at least once
+template <typename NextWord>
+uint64_t UniformBelow(uint64_t bound, NextWord&& next_word) {
+  __uint128_t product = static_cast<__uint128_t>(next_word()) * bound;
+  auto low = static_cast<uint64_t>(product);
+
+  if (low < bound) {
+    // -bound % bound == (2^64 - bound) % bound
+    uint64_t threshold = -bound % bound;
+    while (low < threshold) {
+      product = static_cast<__uint128_t>(next_word()) * bound;
+      low = static_cast<uint64_t>(product);
+    }
+  }
+
+  return static_cast<uint64_t>(product >> 64);
+}
+
+}  // namespace whirl::node::random
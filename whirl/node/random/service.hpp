@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdlib>
 
 namespace whirl::node::random {
 
@@ -9,6 +10,19 @@ struct IRandomService {
 
   // [0, bound)
   virtual uint64_t GenerateNumber(uint64_t bound) = 0;
+
+  // Fills `words` with uniformly distributed 64-bit words
+  // Engines are expected to override it with a batch generator
+  virtual void GenerateWords(uint64_t* words, size_t count) {
+    // Full range from two 32-bit halves: bound is exclusive,
+    // so GenerateNumber alone never yields 2^64 - 1
+    static const uint64_t kHalf = uint64_t{1} << 32;
+    for (size_t i = 0; i < count; ++i) {
+      uint64_t hi = GenerateNumber(kHalf);
+      uint64_t lo = GenerateNumber(kHalf);
+      words[i] = (hi << 32) | lo;
+    }
+  }
 };
 
 }  // namespace whirl::node::random
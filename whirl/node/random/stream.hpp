@@ -0,0 +1,73 @@
+#pragma once
+
+#include <whirl/node/random/service.hpp>
+#include <whirl/node/random/xoshiro.hpp>
+#include <whirl/node/random/bounded.hpp>
+
+#include <limits>
+
+namespace whirl::node::random {
+
+// Deterministic local random substream
+// Seeded once from the node random service, then generates numbers without
+// virtual calls. Keep one stream per fiber / component so that
+// randomness does not serialize on the shared service
+
+class Stream : public IRandomService {
+ public:
+  explicit Stream(uint64_t seed) : generator_(seed) {
+  }
+
+  // Single batch call to `parent`
+  explicit Stream(IRandomService* parent) : Stream(SeedFrom(parent)) {
+  }
+
+  uint64_t Word() {
+    return generator_.Next();
+  }
+
+  // [0, bound), unbiased
+  uint64_t Number(uint64_t bound) {
+    return UniformBelow(bound, [this]() {
+      return generator_.Next();
+    });
+  }
+
+  // [lo, hi], unbiased
+  uint64_t Number(uint64_t lo, uint64_t hi) {
+    uint64_t span = hi - lo;
+    if (span == std::numeric_limits<uint64_t>::max()) {
+      return Word();
+    }
+    return lo + Number(span + 1);
+  }
+
+  // Child stream that does not overlap with this one
+  Stream Split() {
+    Stream child = *this;
+    generator_.Jump();
+    return child;
+  }
+
+  // IRandomService
+
+  uint64_t GenerateNumber(uint64_t bound) override {
+    return Number(bound);
+  }
+
+  void GenerateWords(uint64_t* words, size_t count) override {
+    generator_.Fill(words, count);
+  }
+
+ private:
+  static uint64_t SeedFrom(IRandomService* parent) {
+    uint64_t seed;
+    parent->GenerateWords(&seed, 1);
+    return seed;
+  }
+
+ private:
+  Xoshiro256 generator_;
+};
+
+}  // namespace whirl::node::random
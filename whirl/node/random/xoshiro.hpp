@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace whirl::node::random {
+
+// xoshiro256** by Blackman & Vigna
+// https://prng.di.unimi.it/
+
+class Xoshiro256 {
+ public:
+  explicit Xoshiro256(uint64_t seed) {
+    // Expand seed with SplitMix64, state must not be all zeros
+    for (auto& word : state_) {
+      seed += 0x9e3779b97f4a7c15;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  uint64_t Next() {
+    const uint64_t result = Rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+
+    state_[2] ^= t;
+    state_[3] = Rotl(state_[3], 45);
+
+    return result;
+  }
+
+  void Fill(uint64_t* words, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      words[i] = Next();
+    }
+  }
+
+  // Equivalent to 2^128 calls to Next
+  // Used to generate non-overlapping substreams
+  void Jump() {
+    static const uint64_t kJump[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                                     0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+
+    uint64_t jumped[4] = {0, 0, 0, 0};
+    for (uint64_t mask : kJump) {
+      for (int bit = 0; bit < 64; ++bit) {
+        if (mask & (uint64_t{1} << bit)) {
+          for (int i = 0; i < 4; ++i) {
+            jumped[i] ^= state_[i];
+          }
+        }
+        Next();
+      }
+    }
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = jumped[i];
+    }
+  }
+
+ private:
+  static uint64_t Rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+ private:
+  uint64_t state_[4];
+};
+
+}  // namespace whirl::node::random
@@ -1,5 +1,9 @@
 #include <whirl/node/rpc/random.hpp>
 
+#include <whirl/node/random/stream.hpp>
+
+#include <optional>
+
 using await::futures::Future;
 
 using commute::rpc::CallOptions;
@@ -42,13 +46,19 @@ class RandomChannel : public IChannel {
   }
 
  private:
-  size_t SelectIndex() const {
-    return random_->GenerateNumber(channels_.size());
+  size_t SelectIndex() {
+    if (!stream_.has_value()) {
+      // Seed on first call: construction may happen outside of node context
+      stream_.emplace(random_);
+    }
+    return stream_->Number(channels_.size());
   }
 
  private:
   std::vector<IChannelPtr> channels_;
   node::random::IRandomService* random_;
+  // Local substream: no virtual call per message
+  std::optional<node::random::Stream> stream_;
 };
 
 //////////////////////////////////////////////////////////////////////
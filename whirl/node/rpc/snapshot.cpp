@@ -0,0 +1,128 @@
+#include <whirl/node/rpc/snapshot.hpp>
+
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace whirl::node::rpc {
+
+static void PutVarint(std::string& output, uint64_t value) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+// Records come from a peer: malformed input is not a local bug
+
+static std::optional<uint64_t> GetVarint(std::string_view& input) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < input.size() && i < 10; ++i) {
+    uint8_t byte = input[i];
+    value |= uint64_t(byte & 0x7F) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      input.remove_prefix(i + 1);
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+static std::optional<std::string_view> GetBytes(std::string_view& input) {
+  auto size = GetVarint(input);
+  if (!size.has_value() || *size > input.size()) {
+    return std::nullopt;
+  }
+  auto bytes = input.substr(0, *size);
+  input.remove_prefix(*size);
+  return bytes;
+}
+
+// Deletes in bounded batches: memory does not depend on db size
+static void Clear(db::IDatabase* db) {
+  static const size_t kBatchSize = 1024;
+
+  db::WriteBatch batch;
+
+  auto snapshot = db->MakeSnapshot();
+  auto it = snapshot->MakeIterator();
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    batch.Delete(db::Key{it->Key()});
+    if (batch.muts.size() == kBatchSize) {
+      db->Write(std::move(batch));
+      batch.muts.clear();
+    }
+  }
+
+  if (!batch.muts.empty()) {
+    db->Write(std::move(batch));
+  }
+}
+
+// std::nullopt at the end of stream or on abort (sets `aborted`)
+static std::optional<std::string> ReadChunk(StreamReceiver& receiver,
+                                            bool& aborted) {
+  try {
+    return receiver.Read();
+  } catch (const std::runtime_error&) {
+    aborted = true;
+    return std::nullopt;
+  }
+}
+
+size_t SendSnapshot(db::ISnapshotPtr snapshot, StreamWriter& writer) {
+  size_t count = 0;
+  std::string record;
+
+  auto it = snapshot->MakeIterator();
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    record.clear();
+    PutVarint(record, it->Key().size());
+    record.append(it->Key());
+    PutVarint(record, it->Value().size());
+    record.append(it->Value());
+
+    // Blocks while receiver is behind
+    writer.Write(record);
+    ++count;
+  }
+
+  writer.Finish();
+  return count;
+}
+
+std::optional<size_t> InstallSnapshot(StreamReceiver& receiver,
+                                      db::IDatabase* db) {
+  Clear(db);
+
+  size_t count = 0;
+  bool aborted = false;
+
+  while (auto chunk = ReadChunk(receiver, aborted)) {
+    db::WriteBatch batch;
+
+    std::string_view records{*chunk};
+    while (!records.empty()) {
+      auto key = GetBytes(records);
+      auto value = key.has_value() ? GetBytes(records) : std::nullopt;
+      if (!value.has_value()) {
+        receiver.Fail();
+        return std::nullopt;
+      }
+      batch.Put(db::Key{*key}, db::Value{*value});
+    }
+
+    count += batch.muts.size();
+    db->Write(std::move(batch));
+  }
+
+  if (aborted) {
+    // Truncated stream: writer failed or went silent
+    return std::nullopt;
+  }
+
+  return count;
+}
+
+}  // namespace whirl::node::rpc
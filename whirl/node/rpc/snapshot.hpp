@@ -0,0 +1,29 @@
+#pragma once
+
+#include <whirl/node/rpc/stream.hpp>
+
+#include <whirl/node/db/database.hpp>
+
+#include <optional>
+
+namespace whirl::node::rpc {
+
+// Snapshot transfer over streams
+// Record: [varint key size][key][varint value size][value]
+
+// Iterates snapshot at the pace of the receiver
+// Returns number of transferred records
+size_t SendSnapshot(db::ISnapshotPtr snapshot, StreamWriter& writer);
+
+// Replaces contents of `db` with received records:
+// deletes existing keys in bounded batches, then writes one WriteBatch
+// per chunk
+// On malformed records fails the stream (see StreamReceiver::Fail) and
+// returns std::nullopt; an aborted or timed out stream (see
+// StreamReceiver::Read) also returns std::nullopt.
+// In both cases `db` is left with a partial snapshot
+// Returns number of installed records
+std::optional<size_t> InstallSnapshot(StreamReceiver& receiver,
+                                      db::IDatabase* db);
+
+}  // namespace whirl::node::rpc
@@ -0,0 +1,295 @@
+#include <whirl/node/rpc/stream.hpp>
+
+#include <whirl/node/runtime/shortcuts.hpp>
+
+#include <await/fibers/sync/future.hpp>
+
+#include <muesli/serialize.hpp>
+
+#include <fmt/core.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace whirl::node::rpc {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+await::futures::Future<void> Waiters::Park() {
+  auto [future, promise] = await::futures::MakeContract<void>();
+  waiters_.push_back(std::move(promise));
+  return std::move(future);
+}
+
+void Waiters::Wake(std::vector<await::futures::Promise<void>> waiters) {
+  for (auto& waiter : waiters) {
+    std::move(waiter).SetValue();
+  }
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+StreamWriter::StreamWriter(commute::rpc::IChannelPtr channel,
+                           commute::rpc::Method method, std::string stream_id,
+                           Params params)
+    : channel_(std::move(channel)),
+      method_(std::move(method)),
+      stream_id_(std::move(stream_id)),
+      params_(params),
+      state_(std::make_shared<State>()) {
+  state_->window_end = params_.initial_window;
+}
+
+StreamWriter::~StreamWriter() {
+  if (!done_) {
+    Abort();
+  }
+}
+
+template <typename Predicate>
+void StreamWriter::WaitUntil(Predicate predicate) {
+  while (true) {
+    std::optional<await::futures::Future<void>> changed;
+    {
+      std::lock_guard guard(state_->mutex);
+      if (state_->failed) {
+        throw std::runtime_error(
+            fmt::format("Stream '{}' failed", stream_id_));
+      }
+      if (predicate(*state_)) {
+        return;
+      }
+      changed.emplace(state_->waiters.Park());
+    }
+    await::fibers::Await(std::move(*changed)).ExpectOk();
+  }
+}
+
+void StreamWriter::Write(std::string_view data) {
+  if (!chunk_.empty() && chunk_.size() + data.size() > params_.chunk_size) {
+    Send(/*last=*/false);
+  }
+  chunk_.append(data);
+}
+
+void StreamWriter::Finish() {
+  Send(/*last=*/true);
+  WaitUntil([](const State& state) {
+    return state.in_flight == 0;
+  });
+  done_ = true;
+}
+
+void StreamWriter::Abort() {
+  if (done_) {
+    return;
+  }
+  done_ = true;
+
+  StreamChunk chunk{stream_id_, next_seq_++, {}, /*last=*/true,
+                    /*abort=*/true};
+  // No acks expected: receiver may be gone already
+  channel_->Call(method_, muesli::Serialize(chunk), {})
+      .Subscribe([](wheels::Result<commute::rpc::Message>) {
+      });
+}
+
+void StreamWriter::Send(bool last) {
+  uint64_t seq = next_seq_++;
+
+  // Backpressure
+  WaitUntil([seq](const State& state) {
+    return seq < state.window_end;
+  });
+
+  {
+    std::lock_guard guard(state_->mutex);
+    ++state_->in_flight;
+  }
+
+  StreamChunk chunk{stream_id_, seq, std::move(chunk_), last};
+  chunk_.clear();
+
+  channel_->Call(method_, muesli::Serialize(chunk), {})
+      .Subscribe([state = state_](
+                     wheels::Result<commute::rpc::Message> result) {
+        std::vector<await::futures::Promise<void>> waiters;
+        {
+          std::lock_guard guard(state->mutex);
+          --state->in_flight;
+          if (result.IsOk()) {
+            auto ack = muesli::Deserialize<StreamAck>(*result);
+            state->window_end = std::max(state->window_end, ack.window_end);
+          } else {
+            state->failed = true;
+          }
+          waiters = state->waiters.TakeAll();
+        }
+        detail::Waiters::Wake(std::move(waiters));
+      });
+}
+
+//////////////////////////////////////////////////////////////////////
+
+StreamReceiver::StreamReceiver(Params params) : params_(params) {
+}
+
+std::vector<await::futures::Promise<void>> StreamReceiver::Abort() {
+  aborted_ = true;
+  buffer_.clear();
+
+  auto waiters = readers_.TakeAll();
+  for (auto& handler : handlers_.TakeAll()) {
+    waiters.push_back(std::move(handler));
+  }
+  return waiters;
+}
+
+void StreamReceiver::OnIdle(uint64_t pushes) {
+  std::vector<await::futures::Promise<void>> waiters;
+  {
+    std::lock_guard guard(mutex_);
+    if (pushes_ != pushes || finished_ || aborted_) {
+      return;  // Progress since the timer was armed
+    }
+    waiters = Abort();
+  }
+  detail::Waiters::Wake(std::move(waiters));
+}
+
+StreamAck StreamReceiver::Push(StreamChunk chunk) {
+  uint64_t seq = chunk.seq;
+  bool last = chunk.last;
+  // Buffered or already consumed
+  bool accepted = false;
+
+  {
+    std::lock_guard guard(mutex_);
+    ++pushes_;
+  }
+
+  if (chunk.abort) {
+    std::vector<await::futures::Promise<void>> waiters;
+    {
+      std::lock_guard guard(mutex_);
+      if (finished_) {
+        return StreamAck{WindowEnd()};
+      }
+      waiters = Abort();
+    }
+    detail::Waiters::Wake(std::move(waiters));
+    return StreamAck{WindowEnd()};
+  }
+
+  while (true) {
+    std::vector<await::futures::Promise<void>> readers;
+    std::optional<StreamAck> ack;
+    std::optional<await::futures::Future<void>> changed;
+
+    {
+      std::lock_guard guard(mutex_);
+
+      if (aborted_) {
+        // `chunk` may be moved to the buffer already
+        throw std::runtime_error("Stream aborted by receiver");
+      }
+
+      if (!accepted && seq < consumed_) {
+        accepted = true;  // Duplicate of consumed chunk
+      }
+      if (!accepted && seq < WindowEnd()) {
+        // New or duplicate within window
+        if (buffer_.try_emplace(seq, std::move(chunk)).second) {
+          readers = readers_.TakeAll();
+        }
+        accepted = true;
+      }
+
+      // Done: chunk accepted and there is room beyond it
+      // or no more chunks expected
+      // Chunks beyond the window (including the last one) wait
+      // until the window reaches them
+      if (accepted && (last || seq + 1 < WindowEnd())) {
+        ack = StreamAck{WindowEnd()};
+      } else {
+        changed.emplace(handlers_.Park());
+      }
+    }
+
+    detail::Waiters::Wake(std::move(readers));
+
+    if (ack.has_value()) {
+      return *ack;
+    }
+    await::fibers::Await(std::move(*changed)).ExpectOk();
+  }
+}
+
+std::optional<std::string> StreamReceiver::Read() {
+  while (true) {
+    std::optional<await::futures::Future<void>> changed;
+    uint64_t pushes;
+    {
+      std::unique_lock lock(mutex_);
+
+      if (aborted_) {
+        throw std::runtime_error("Stream aborted");
+      }
+      if (finished_) {
+        return std::nullopt;
+      }
+
+      auto it = buffer_.find(consumed_);
+      if (it != buffer_.end()) {
+        auto chunk = std::move(it->second);
+        buffer_.erase(it);
+        ++consumed_;
+        finished_ = chunk.last;
+
+        // Window moved: release blocked handlers
+        auto handlers = handlers_.TakeAll();
+        lock.unlock();
+        detail::Waiters::Wake(std::move(handlers));
+
+        if (chunk.last && chunk.data.empty()) {
+          return std::nullopt;
+        }
+        return std::move(chunk.data);
+      }
+
+      changed.emplace(readers_.Park());
+      pushes = pushes_;
+    }
+
+    if (params_.idle_timeout.Count() == 0) {
+      await::fibers::Await(std::move(*changed)).ExpectOk();
+      continue;
+    }
+
+    auto timer = rt::TimeService()->ArmTimer(params_.idle_timeout);
+    std::move(timer.fired)
+        .Subscribe([this, pushes](wheels::Result<void> result) {
+          if (result.IsOk()) {
+            OnIdle(pushes);
+          }
+        });
+    await::fibers::Await(std::move(*changed)).ExpectOk();
+    // Receiver may be gone before the timer fires
+    timer.cancel();
+  }
+}
+
+void StreamReceiver::Fail() {
+  std::vector<await::futures::Promise<void>> waiters;
+  {
+    std::lock_guard guard(mutex_);
+    waiters = Abort();
+  }
+  detail::Waiters::Wake(std::move(waiters));
+}
+
+}  // namespace whirl::node::rpc
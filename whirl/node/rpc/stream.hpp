@@ -0,0 +1,223 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+
+#include <commute/rpc/channel.hpp>
+
+#include <await/futures/core/future.hpp>
+
+#include <muesli/serializable.hpp>
+
+#include <cereal/types/string.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace whirl::node::rpc {
+
+// Streaming transfer over unary RPC calls with credit-based flow control
+//
+// Writer sends chunks as calls to `method`, receiver service handles them
+// with StreamReceiver::Push. Each ack carries the receiver window:
+// writer may have chunks with seq < window_end in flight, receiver buffers
+// at most `window` chunks, so memory is bounded on both ends
+//
+// Receiver side:
+//
+// void Push(StreamChunk chunk) -> StreamAck {  // RPC method handler
+//   return receivers_[chunk.stream_id]->Push(std::move(chunk));
+// }
+//
+// while (auto data = receiver.Read()) { ... }
+//
+// Sender side:
+//
+// StreamWriter writer{channel, push_method, stream_id};
+// writer.Write(data);  // Blocks when receiver is behind
+// writer.Finish();
+//
+// Failures: writer destroyed without Finish sends an abort chunk,
+// receiver fails the stream after `idle_timeout` without chunks
+// (e.g. writer node crashed)
+
+struct StreamChunk {
+  std::string stream_id;
+  uint64_t seq;
+  std::string data;
+  bool last;
+  // Writer gave up, `data` is empty
+  bool abort = false;
+
+  MUESLI_SERIALIZABLE(stream_id, seq, data, last, abort)
+};
+
+struct StreamAck {
+  // Writer may send chunks with seq < window_end
+  uint64_t window_end;
+
+  MUESLI_SERIALIZABLE(window_end)
+};
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Fibers waiting for a state change
+class Waiters {
+ public:
+  // Under state mutex
+  await::futures::Future<void> Park();
+
+  // Outside of state mutex
+  static void Wake(std::vector<await::futures::Promise<void>> waiters);
+
+  std::vector<await::futures::Promise<void>> TakeAll() {
+    return std::move(waiters_);
+  }
+
+ private:
+  std::vector<await::futures::Promise<void>> waiters_;
+};
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+class StreamWriter {
+ public:
+  struct Params {
+    // Chunk is sent when it reaches this size
+    size_t chunk_size = 64 * 1024;
+    // Chunks in flight before the first ack
+    uint64_t initial_window = 4;
+  };
+
+ private:
+  struct State {
+    std::mutex mutex;
+    uint64_t window_end;
+    uint64_t in_flight = 0;
+    bool failed = false;
+    detail::Waiters waiters;
+  };
+
+ public:
+  StreamWriter(commute::rpc::IChannelPtr channel, commute::rpc::Method method,
+               std::string stream_id, Params params);
+
+  StreamWriter(commute::rpc::IChannelPtr channel, commute::rpc::Method method,
+               std::string stream_id)
+      : StreamWriter(std::move(channel), std::move(method),
+                     std::move(stream_id), Params{}) {
+  }
+
+  // Aborts unfinished stream
+  ~StreamWriter();
+
+  // Non-copyable
+  StreamWriter(const StreamWriter&) = delete;
+  StreamWriter& operator=(const StreamWriter&) = delete;
+
+  // Appends `data` to the current chunk, `data` is never split
+  // between chunks
+  // Blocks current fiber while receiver window is exhausted
+  // Throws std::runtime_error if stream failed
+  void Write(std::string_view data);
+
+  // Sends the last chunk and waits for all acks
+  void Finish();
+
+  // Best effort: tells receiver to fail the stream, does not wait
+  void Abort();
+
+  uint64_t ChunksSent() const {
+    return next_seq_;
+  }
+
+ private:
+  void Send(bool last);
+
+  // Waits until `predicate` holds under state mutex
+  template <typename Predicate>
+  void WaitUntil(Predicate predicate);
+
+ private:
+  commute::rpc::IChannelPtr channel_;
+  const commute::rpc::Method method_;
+  const std::string stream_id_;
+  const Params params_;
+
+  std::string chunk_;
+  uint64_t next_seq_ = 0;
+  bool done_ = false;  // Finished or aborted
+
+  std::shared_ptr<State> state_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class StreamReceiver {
+ public:
+  struct Params {
+    // Max buffered chunks
+    uint64_t window = 8;
+    // Read fails the stream if no chunks arrive for this long,
+    // 0 - wait forever
+    Jiffies idle_timeout = 10'000;
+  };
+
+  explicit StreamReceiver(Params params);
+
+  StreamReceiver() : StreamReceiver(Params{}) {
+  }
+
+  // RPC handler side
+  // Blocks handler fiber until the chunk is buffered and there is room
+  // beyond it: ack is the only way writer learns about new credits
+  // Chunk is acked only after it is buffered
+  // Duplicates (retries) are acked and dropped
+  StreamAck Push(StreamChunk chunk);
+
+  // Next chunk payload in order, std::nullopt at the end of stream
+  // Blocks current fiber
+  // Throws std::runtime_error if stream is aborted: by writer,
+  // by idle timeout or by Fail
+  std::optional<std::string> Read();
+
+  // Reader side: aborts the stream (e.g. malformed payload)
+  // Pending and subsequent Push calls throw std::runtime_error,
+  // so the writer fails
+  void Fail();
+
+ private:
+  uint64_t WindowEnd() const {
+    return consumed_ + params_.window;
+  }
+
+  // Under mutex
+  std::vector<await::futures::Promise<void>> Abort();
+
+  void OnIdle(uint64_t pushes);
+
+ private:
+  const Params params_;
+
+  std::mutex mutex_;
+  // seq -> chunk, seq in [consumed_, consumed_ + window_)
+  std::map<uint64_t, StreamChunk> buffer_;
+  uint64_t consumed_ = 0;
+  bool finished_ = false;
+  bool aborted_ = false;
+  // Push calls so far, for idle detection
+  uint64_t pushes_ = 0;
+
+  detail::Waiters readers_;
+  detail::Waiters handlers_;
+};
+
+}  // namespace whirl::node::rpc
@@ -0,0 +1,90 @@
+#include <whirl/node/runtime/fiber_pool.hpp>
+
+#include <whirl/node/runtime/shortcuts.hpp>
+
+#include <await/fibers/sync/future.hpp>
+
+#include <algorithm>
+
+namespace whirl::node::rt {
+
+FiberPool::FiberPool(size_t max_idle) : state_(std::make_shared<State>()) {
+  state_->max_idle = max_idle;
+}
+
+FiberPool::~FiberPool() {
+  std::vector<Handoff> idle;
+  {
+    std::lock_guard guard(state_->mutex);
+    state_->closed = true;
+    idle.swap(state_->idle);
+  }
+  for (auto& handoff : idle) {
+    std::move(handoff).SetValue(std::nullopt);
+  }
+}
+
+void FiberPool::Go(Routine routine) {
+  std::vector<Routine> batch;
+  batch.push_back(std::move(routine));
+  GoBatch(std::move(batch));
+}
+
+void FiberPool::GoBatch(std::vector<Routine> routines) {
+  std::vector<Handoff> parked;
+  {
+    std::lock_guard guard(state_->mutex);
+    size_t count = std::min(routines.size(), state_->idle.size());
+    for (size_t i = 0; i < count; ++i) {
+      parked.push_back(std::move(state_->idle.back()));
+      state_->idle.pop_back();
+    }
+    state_->counters.reused += count;
+    state_->counters.created += routines.size() - count;
+  }
+
+  size_t i = 0;
+  for (; i < parked.size(); ++i) {
+    std::move(parked[i]).SetValue(std::move(routines[i]));
+  }
+  for (; i < routines.size(); ++i) {
+    Spawn(state_, std::move(routines[i]));
+  }
+}
+
+SpawnCounters FiberPool::Counters() const {
+  std::lock_guard guard(state_->mutex);
+  return state_->counters;
+}
+
+void FiberPool::Spawn(std::shared_ptr<State> state, Routine first) {
+  rt::Go([state = std::move(state), first = std::move(first)]() mutable {
+    Work(state, std::move(first));
+  });
+}
+
+void FiberPool::Work(const std::shared_ptr<State>& state, Routine first) {
+  std::optional<Routine> routine = std::move(first);
+
+  while (routine.has_value()) {
+    (*routine)();
+
+    auto [next, handoff] =
+        await::futures::MakeContract<std::optional<Routine>>();
+    {
+      std::lock_guard guard(state->mutex);
+      if (state->closed || state->idle.size() >= state->max_idle) {
+        return;  // Fiber and its stack are released
+      }
+      state->idle.push_back(std::move(handoff));
+    }
+
+    auto result = await::fibers::Await(std::move(next));
+    if (!result.IsOk()) {
+      return;
+    }
+    routine = std::move(*result);
+  }
+}
+
+}  // namespace whirl::node::rt
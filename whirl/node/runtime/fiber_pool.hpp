@@ -0,0 +1,69 @@
+#pragma once
+
+#include <await/fibers/core/api.hpp>
+#include <await/futures/core/future.hpp>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace whirl::node::rt {
+
+struct SpawnCounters {
+  // New fibers (and stacks) created
+  size_t created = 0;
+  // Routines handed to parked fibers
+  size_t reused = 0;
+
+  double HitRate() const {
+    size_t total = created + reused;
+    return total == 0 ? 0.0 : static_cast<double>(reused) / total;
+  }
+};
+
+// Pool of parked worker fibers: finished fibers wait for the next routine
+// instead of being destroyed, so per-request spawn does not allocate
+// a fiber and a stack
+//
+// One pool per node, must be destroyed before the node runtime
+
+class FiberPool {
+  using Routine = await::fibers::FiberRoutine;
+  // std::nullopt - stop
+  using Handoff = await::futures::Promise<std::optional<Routine>>;
+
+  struct State {
+    std::mutex mutex;
+    std::vector<Handoff> idle;
+    size_t max_idle;
+    bool closed = false;
+    SpawnCounters counters;
+  };
+
+ public:
+  explicit FiberPool(size_t max_idle = 64);
+
+  // Stops parked fibers, running routines are not interrupted
+  ~FiberPool();
+
+  // Non-copyable
+  FiberPool(const FiberPool&) = delete;
+  FiberPool& operator=(const FiberPool&) = delete;
+
+  void Go(Routine routine);
+
+  // Single pass over idle fibers for the whole batch
+  void GoBatch(std::vector<Routine> routines);
+
+  SpawnCounters Counters() const;
+
+ private:
+  static void Spawn(std::shared_ptr<State> state, Routine first);
+  static void Work(const std::shared_ptr<State>& state, Routine first);
+
+ private:
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace whirl::node::rt
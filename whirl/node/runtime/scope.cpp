@@ -0,0 +1,144 @@
+#include <whirl/node/runtime/scope.hpp>
+
+#include <await/fibers/sync/future.hpp>
+
+namespace whirl::node::rt {
+
+namespace detail {
+
+//////////////////////////////////////////////////////////////////////
+
+std::optional<uint64_t> ScopeState::OnCancel(Callback callback) {
+  {
+    std::lock_guard guard(mutex);
+    if (!cancelled.load()) {
+      uint64_t id = next_callback_id++;
+      on_cancel.emplace(id, std::move(callback));
+      return id;
+    }
+  }
+  callback();
+  return std::nullopt;
+}
+
+void ScopeState::Forget(uint64_t id) {
+  std::lock_guard guard(mutex);
+  on_cancel.erase(id);
+}
+
+void ScopeState::Cancel() {
+  std::map<uint64_t, Callback> callbacks;
+  {
+    std::lock_guard guard(mutex);
+    if (cancelled.exchange(true)) {
+      return;
+    }
+    callbacks.swap(on_cancel);
+  }
+  // Outside of critical section: stop callbacks and on_cancel
+  // callbacks resume fibers
+  stop_source.RequestStop();
+  for (auto& [_, callback] : callbacks) {
+    callback();
+  }
+}
+
+void ScopeState::Enter() {
+  std::lock_guard guard(mutex);
+  ++active;
+}
+
+void ScopeState::Exit() {
+  std::vector<await::futures::Promise<void>> waiters;
+  {
+    std::lock_guard guard(mutex);
+    if (--active > 0) {
+      return;
+    }
+    waiters.swap(joiners);
+  }
+  for (auto& waiter : waiters) {
+    std::move(waiter).SetValue();
+  }
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+Scope::Scope() : state_(std::make_shared<detail::ScopeState>()) {
+}
+
+Scope::Scope(Scope& parent) : Scope() {
+  parent_ = parent.state_;
+  parent_link_ = parent_->OnCancel([state = state_]() {
+    state->Cancel();
+  });
+}
+
+Scope::~Scope() {
+  Cancel();
+  Join();
+
+  if (parent_link_.has_value()) {
+    parent_->Forget(*parent_link_);
+  }
+}
+
+void Scope::Go(await::fibers::FiberRoutine routine) {
+  state_->Enter();
+
+  rt::Go([state = state_, routine = std::move(routine)]() mutable {
+    // Exit even if routine throws
+    struct ExitGuard {
+      detail::ScopeState* state;
+      ~ExitGuard() {
+        state->Exit();
+      }
+    } guard{state.get()};
+
+    if (!state->cancelled.load()) {
+      routine();
+    }
+  });
+}
+
+void Scope::Join() {
+  std::optional<await::futures::Future<void>> joined;
+  {
+    std::lock_guard guard(state_->mutex);
+    if (state_->active == 0) {
+      return;
+    }
+    auto [future, joiner] = await::futures::MakeContract<void>();
+    state_->joiners.push_back(std::move(joiner));
+    joined.emplace(std::move(future));
+  }
+  await::fibers::Await(std::move(*joined)).ExpectOk();
+}
+
+void Scope::Cancel() {
+  state_->Cancel();
+}
+
+await::futures::Future<commute::rpc::Message> Scope::Call(
+    commute::rpc::IChannel& channel, const commute::rpc::Method& method,
+    const commute::rpc::Message& input, commute::rpc::CallOptions options) {
+  options.stop_advice = StopAdvice();
+  return Guard(channel.Call(method, input, std::move(options)));
+}
+
+bool Scope::SleepFor(Jiffies delay) {
+  auto timer = TimeService()->ArmTimer(delay);
+
+  // Released timer resolves `fired` with an error
+  auto id = state_->OnCancel(timer.cancel);
+  bool fired = Await(std::move(timer.fired)).IsOk();
+
+  if (id.has_value()) {
+    state_->Forget(*id);
+  }
+  return fired;
+}
+
+}  // namespace whirl::node::rt
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <whirl/node/runtime/shortcuts.hpp>
+
+#include <commute/rpc/channel.hpp>
+
+#include <await/context/stop_token.hpp>
+#include <await/futures/core/future.hpp>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+namespace whirl::node::rt {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+struct ScopeState {
+  using Callback = std::function<void()>;
+
+  std::mutex mutex;
+  size_t active = 0;
+  std::atomic<bool> cancelled{false};
+  // Propagates cancellation out of the scope (rpc retries)
+  await::context::StopSource stop_source;
+  uint64_t next_callback_id = 0;
+  std::map<uint64_t, Callback> on_cancel;
+  std::vector<await::futures::Promise<void>> joiners;
+
+  // Invokes callback immediately if already cancelled
+  std::optional<uint64_t> OnCancel(Callback callback);
+  void Forget(uint64_t id);
+
+  void Cancel();
+
+  void Enter();
+  void Exit();
+};
+
+// First of (completion, cancellation) resolves the promise
+template <typename T>
+class Race {
+ public:
+  explicit Race(await::futures::Promise<T> promise)
+      : promise_(std::move(promise)) {
+  }
+
+  void Complete(wheels::Result<T> result) {
+    if (!done_.exchange(true)) {
+      std::move(*promise_).Set(std::move(result));
+    }
+  }
+
+  void Cancel() {
+    if (!done_.exchange(true)) {
+      std::move(*promise_).SetError(
+          std::make_error_code(std::errc::operation_canceled));
+    }
+  }
+
+ private:
+  std::atomic<bool> done_{false};
+  std::optional<await::futures::Promise<T>> promise_;
+};
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Cheap copyable view of scope cancellation (e.g. for retry loops)
+
+class StopToken {
+ public:
+  explicit StopToken(std::shared_ptr<detail::ScopeState> state)
+      : state_(std::move(state)) {
+  }
+
+  bool StopRequested() const {
+    return state_->cancelled.load();
+  }
+
+ private:
+  std::shared_ptr<detail::ScopeState> state_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Nursery for fibers: fibers spawned via scope.Go share cancellation
+// and are joined together
+//
+// Cancellation is cooperative: not started routines are skipped,
+// guarded futures (Guard / Await / SleepFor) resolve with
+// std::errc::operation_canceled, routines can poll Token()
+// Work started via Call / SleepFor is stopped too: rpc calls get
+// StopAdvice() in CallOptions, sleep timers are released
+//
+// Usage:
+//
+// rt::Scope scope;
+// for (auto& peer : peers) {
+//   scope.Go([&] {
+//     auto result = scope.Await(scope.Call(*peer, ...));
+//     if (result.IsOk() && ++acks == quorum) {
+//       scope.Cancel();  // Cancel losers
+//     }
+//   });
+// }
+// scope.Join();
+
+class Scope {
+ public:
+  Scope();
+
+  // Child scope is cancelled with its parent
+  explicit Scope(Scope& parent);
+
+  // Cancels and joins remaining fibers
+  // Must be destroyed in fiber context
+  ~Scope();
+
+  // Non-copyable
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  void Go(await::fibers::FiberRoutine routine);
+
+  // Blocks current fiber until all scope fibers complete
+  void Join();
+
+  void Cancel();
+
+  bool IsCancelled() const {
+    return state_->cancelled.load();
+  }
+
+  StopToken Token() const {
+    return StopToken{state_};
+  }
+
+  // Scope cancellation for await-aware code, e.g. CallOptions
+  await::context::StopToken StopAdvice() const {
+    return state_->stop_source.GetToken();
+  }
+
+  // Guarded rpc call, options.stop_advice is set to StopAdvice():
+  // channel (retry loop) stops on scope cancellation
+  await::futures::Future<commute::rpc::Message> Call(
+      commute::rpc::IChannel& channel, const commute::rpc::Method& method,
+      const commute::rpc::Message& input,
+      commute::rpc::CallOptions options = {});
+
+  // Future that also resolves (with an error) on scope cancellation
+  template <typename T>
+  await::futures::Future<T> Guard(await::futures::Future<T> future) {
+    auto [guarded, promise] = await::futures::MakeContract<T>();
+    auto race = std::make_shared<detail::Race<T>>(std::move(promise));
+
+    auto id = state_->OnCancel([race]() {
+      race->Cancel();
+    });
+
+    std::move(future).Subscribe(
+        [state = state_, race, id](wheels::Result<T> result) mutable {
+          if (id.has_value()) {
+            state->Forget(*id);
+          }
+          race->Complete(std::move(result));
+        });
+
+    return std::move(guarded);
+  }
+
+  template <typename T>
+  wheels::Result<T> Await(await::futures::Future<T> future) {
+    return await::fibers::Await(Guard(std::move(future)));
+  }
+
+  // Returns false if interrupted by cancellation
+  // Timer is cancelled with the scope
+  bool SleepFor(Jiffies delay);
+
+ private:
+  std::shared_ptr<detail::ScopeState> state_;
+  std::shared_ptr<detail::ScopeState> parent_;
+  std::optional<uint64_t> parent_link_;
+};
+
+}  // namespace whirl::node::rt
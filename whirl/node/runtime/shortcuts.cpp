@@ -1,5 +1,6 @@
 #include <whirl/node/runtime/shortcuts.hpp>
 
+#include <await/executors/execute.hpp>
 #include <await/fibers/core/fiber.hpp>
 #include <await/fibers/static/services.hpp>
 
@@ -7,23 +8,66 @@
 
 namespace whirl::node::rt {
 
-// [lo, hi]
-uint64_t RandomNumber(uint64_t lo, uint64_t hi) {
-  WHEELS_VERIFY(lo <= hi, "lo > hi");
-  return lo + RandomNumber(hi - lo + 1);
+random::Stream& RandomStream() {
+  auto& runtime = GetRuntime();
+  auto& stream = runtime.Locals()->random;
+  if (!stream.has_value()) {
+    // Single batch call to the node random service
+    stream.emplace(runtime.RandomService());
+  }
+  return *stream;
 }
 
-size_t RandomIndex(size_t size) {
-  WHEELS_VERIFY(size > 0, "size == 0");
-  return RandomNumber(/*bound=*/size);
+void WaitUntilAfter(time::WallTime t) {
+  while (true) {
+    // Cached interval would not advance `earliest` between sleeps
+    time::TTInterval now = TrueTime()->FreshNow();
+    if (now.earliest > t) {
+      return;
+    }
+    // Usually a single sleep, loop guards against clock adjustments
+    SleepFor((t - now.earliest) + 1);
+  }
 }
 
-void Go(await::fibers::FiberRoutine routine) {
-  auto* f = await::fibers::CreateFiber(
-      std::move(routine), FiberManager(), Executor(),
+static await::fibers::Fiber* CreateFiber(IRuntime& runtime,
+                                         await::fibers::FiberRoutine routine) {
+  ++runtime.Locals()->fibers_created;
+  return await::fibers::CreateFiber(
+      std::move(routine), runtime.FiberManager(), runtime.Executor(),
       await::fibers::BackgroundSupervisor(), await::context::NeverStop());
+}
+
+void Go(await::fibers::FiberRoutine routine) {
+  CreateFiber(GetRuntime(), std::move(routine))->Schedule();
+}
+
+void GoBatch(std::vector<await::fibers::FiberRoutine> routines) {
+  if (routines.empty()) {
+    return;
+  }
+
+  auto& runtime = GetRuntime();
+
+  std::vector<await::fibers::Fiber*> fibers;
+  fibers.reserve(routines.size());
+  for (auto& routine : routines) {
+    fibers.push_back(CreateFiber(runtime, std::move(routine)));
+  }
+
+  // Single executor task starts fibers one after another,
+  // each fiber goes through the executor on its own only after
+  // the first suspension
+  await::executors::Execute(runtime.Executor(),
+                            [fibers = std::move(fibers)]() {
+                              for (auto* fiber : fibers) {
+                                fiber->Run();
+                              }
+                            });
+}
 
-  f->Schedule();
+size_t FibersCreated() {
+  return GetRuntime().Locals()->fibers_created;
 }
 
 }  // namespace whirl::node::rt
@@ -2,6 +2,8 @@
 
 #include <whirl/runtime/access.hpp>
 
+#include <whirl/node/random/stream.hpp>
+
 // RPC
 #include <commute/rpc/client.hpp>
 #include <commute/rpc/server.hpp>
@@ -13,8 +15,12 @@
 // Logging
 #include <timber/backend.hpp>
 
+#include <wheels/support/assert.hpp>
+
 #include <fmt/core.h>
 
+#include <vector>
+
 namespace whirl::node::rt {
 
 // Shortcuts for runtime services
@@ -57,16 +63,34 @@ inline random::IRandomService* RandomService() {
   return GetRuntime().RandomService();
 }
 
-// [0, bound)
+// Local stream of the current node (see RuntimeLocals), seeded once
+// from its random service
+// Each call resolves the runtime, numbers are then generated locally,
+// without calls to the random service
+// For a fiber-private stream use RandomStream().Split()
+random::Stream& RandomStream();
+
+// [0, bound), unbiased
 inline size_t RandomNumber(size_t bound) {
-  return RandomService()->GenerateNumber(bound);
+  return RandomStream().Number(bound);
 }
 
-// [lo, hi]
-uint64_t RandomNumber(uint64_t lo, uint64_t hi);
+// [lo, hi], unbiased
+inline uint64_t RandomNumber(uint64_t lo, uint64_t hi) {
+  WHEELS_VERIFY(lo <= hi, "lo > hi");
+  return RandomStream().Number(lo, hi);
+}
+
+// Uniformly distributed 64-bit words, single call to random service
+inline void RandomWords(uint64_t* words, size_t count) {
+  RandomService()->GenerateWords(words, count);
+}
 
 // [0, size)
-size_t RandomIndex(size_t size);
+inline size_t RandomIndex(size_t size) {
+  WHEELS_VERIFY(size > 0, "size == 0");
+  return RandomNumber(/*bound=*/size);
+}
 
 // Clocks
 
@@ -94,12 +118,22 @@ inline time::ITrueTimeService* TrueTime() {
   return GetRuntime().TrueTime();
 }
 
+// Commit wait: blocks current fiber until TrueTime().After(t)
+// Sleeps for the remaining uncertainty instead of polling
+void WaitUntilAfter(time::WallTime t);
+
 // Database
 
 inline db::IDatabase* Database() {
   return GetRuntime().Database();
 }
 
+// Memory
+
+inline memory::IAllocator* Allocator() {
+  return GetRuntime().Allocator();
+}
+
 // Execution
 
 inline await::executors::IExecutor* Executor() {
@@ -110,8 +144,17 @@ inline await::fibers::IFiberManager* FiberManager() {
   return GetRuntime().FiberManager();
 }
 
+// New fiber per call, not pooled
+// For per-request spawns see rt::FiberPool
 void Go(await::fibers::FiberRoutine routine);
 
+// Creates all fibers, then starts them from a single executor task
+void GoBatch(std::vector<await::fibers::FiberRoutine> routines);
+
+// Number of fibers created via Go / GoBatch by the current node
+// (see RuntimeLocals)
+size_t FibersCreated();
+
 inline void SleepFor(Jiffies delay) {
   await::fibers::Await(After(delay)).ExpectOk();
 }
@@ -128,9 +171,14 @@ inline guids::IGuidGenerator* GuidGenerator() {
   return GetRuntime().GuidGenerator();
 }
 
+// Generate new globally unique identifier
+inline guids::Guid NewGuid() {
+  return GuidGenerator()->Generate();
+}
+
 // Generate new globally unique string
 inline std::string GenerateGuid() {
-  return GetRuntime().GuidGenerator()->Generate();
+  return NewGuid().ToString();
 }
 
 // Config
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <whirl/node/store/kv.hpp>
+#include <whirl/node/store/ordered.hpp>
+
+#include <whirl/node/db/database.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <fmt/core.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace whirl::node::store {
+
+// Persistent mapping: string -> V with secondary indexes
+// Primary records are KVStore<V> records, readable via KVStore<V>
+//
+// Index entries are written in the same WriteBatch as the primary record:
+// kv:{name}:{key} -> V
+// idx:{name}:{index}:{EncodeOrdered(index key)}{key} -> key
+//
+// Put / Delete read the old record to drop its index entries, then
+// write: not atomic with respect to other writers. Concurrent writers
+// to the same key can leave stale index entries: Range / Find skip
+// entries without a record or with a record that no longer maps to
+// the entry, Reindex removes them
+//
+// Range / Find must be called with the index type given to AddIndex
+//
+// Usage:
+//
+// IndexedKVStore<Lease> leases{db, "leases"};
+// leases.AddIndex<uint64_t>("expires", [](const Lease& lease) {
+//   return lease.expires_at;
+// });
+// leases.Put(id, lease);
+// auto expired = leases.Range<uint64_t>("expires", 0, now);
+
+template <typename V>
+class IndexedKVStore {
+ public:
+  using Entry = std::pair<std::string, V>;
+
+ private:
+  // Encoded index key, std::nullopt - not indexed
+  using Extractor = std::function<std::optional<std::string>(const V&)>;
+
+  struct Index {
+    Extractor extract;
+    // I from AddIndex<I>: encodings of different types do not compare
+    std::type_index type;
+  };
+
+ public:
+  IndexedKVStore(db::IDatabase* db, const std::string& name)
+      : db_(db),
+        records_(db, name),
+        namespace_(Records::Namespace(name)),
+        index_namespace_(fmt::format("idx:{}:", name)) {
+  }
+
+  // Non-copyable
+  IndexedKVStore(const IndexedKVStore&) = delete;
+  IndexedKVStore& operator=(const IndexedKVStore&) = delete;
+
+  // Indexes must be declared before the first write
+  // or rebuilt with Reindex
+  // Extractor returns I or std::optional<I> (sparse index)
+  template <typename I, typename F>
+  void AddIndex(const std::string& index, F extractor) {
+    Extractor encoded = [extractor = std::move(extractor)](const V& value)
+        -> std::optional<std::string> {
+      std::optional<I> key = extractor(value);
+      if (key.has_value()) {
+        return EncodeOrdered(*key);
+      }
+      return std::nullopt;
+    };
+    bool added =
+        indexes_.emplace(index, Index{std::move(encoded), typeid(I)}).second;
+    WHEELS_VERIFY(added, fmt::format("Index '{}' already exists", index));
+  }
+
+  void Put(const std::string& key, const V& value) {
+    db::WriteBatch batch;
+
+    auto old_value = TryGet(key);
+    if (old_value.has_value()) {
+      DeleteIndexEntries(batch, key, *old_value);
+    }
+    PutIndexEntries(batch, key, value);
+    batch.Put(records_.WithNamespace(key), Records::Encode(value));
+
+    db_->Write(std::move(batch));
+  }
+
+  bool Has(const std::string& key) const {
+    return records_.Has(key);
+  }
+
+  std::optional<V> TryGet(const std::string& key) const {
+    return records_.TryGet(key);
+  }
+
+  V Get(const std::string& key) const {
+    return records_.Get(key);
+  }
+
+  void Delete(const std::string& key) {
+    auto old_value = TryGet(key);
+    if (!old_value.has_value()) {
+      return;
+    }
+
+    db::WriteBatch batch;
+    DeleteIndexEntries(batch, key, *old_value);
+    batch.Delete(records_.WithNamespace(key));
+
+    db_->Write(std::move(batch));
+  }
+
+  // Entries with index key in [from, to), ordered by index key
+  template <typename I>
+  std::vector<Entry> Range(const std::string& index, const I& from,
+                           const I& to, size_t limit = SIZE_MAX) const {
+    return Scan(index, GetIndex<I>(index),
+                IndexPrefix(index) + EncodeOrdered(from),
+                IndexPrefix(index) + EncodeOrdered(to), limit);
+  }
+
+  // Entries with index key equal to `key`
+  template <typename I>
+  std::vector<Entry> Find(const std::string& index, const I& key,
+                          size_t limit = SIZE_MAX) const {
+    const auto& checked = GetIndex<I>(index);
+    auto prefix = IndexPrefix(index) + EncodeOrdered(key);
+    return Scan(index, checked, prefix, PrefixEnd(prefix), limit);
+  }
+
+  // Rewrites all index entries from primary records
+  void Reindex() {
+    auto snapshot = db_->MakeSnapshot();
+    auto it = snapshot->MakeIterator();
+
+    db::WriteBatch batch;
+
+    // Drop existing entries
+    for (it->Seek(index_namespace_);
+         it->Valid() && it->Key().starts_with(index_namespace_); it->Next()) {
+      batch.Delete(db::Key{it->Key()});
+    }
+
+    for (it->Seek(namespace_);
+         it->Valid() && it->Key().starts_with(namespace_); it->Next()) {
+      auto key = std::string{it->Key().substr(namespace_.size())};
+      auto value = Records::Decode(std::string{it->Value()});
+      PutIndexEntries(batch, key, *value);
+    }
+
+    db_->Write(std::move(batch));
+  }
+
+ private:
+  using Records = KVStore<V>;
+
+  template <typename I>
+  const Index& GetIndex(const std::string& name) const {
+    auto it = indexes_.find(name);
+    WHEELS_VERIFY(it != indexes_.end(),
+                  fmt::format("Index '{}' not found", name));
+    WHEELS_VERIFY(it->second.type == std::type_index(typeid(I)),
+                  fmt::format("Index '{}' is queried with a different type",
+                              name));
+    return it->second;
+  }
+
+  std::string IndexPrefix(const std::string& index) const {
+    return fmt::format("{}{}:", index_namespace_, index);
+  }
+
+  // Smallest string greater than all strings with this prefix
+  static std::string PrefixEnd(std::string prefix) {
+    while (!prefix.empty() && prefix.back() == '\xFF') {
+      prefix.pop_back();
+    }
+    if (!prefix.empty()) {
+      ++prefix.back();
+    }
+    return prefix;
+  }
+
+  void PutIndexEntries(db::WriteBatch& batch, const std::string& key,
+                       const V& value) const {
+    for (const auto& [name, index] : indexes_) {
+      if (auto index_key = index.extract(value)) {
+        batch.Put(IndexPrefix(name) + *index_key + key, key);
+      }
+    }
+  }
+
+  void DeleteIndexEntries(db::WriteBatch& batch, const std::string& key,
+                          const V& value) const {
+    for (const auto& [name, index] : indexes_) {
+      if (auto index_key = index.extract(value)) {
+        batch.Delete(IndexPrefix(name) + *index_key + key);
+      }
+    }
+  }
+
+  std::vector<Entry> Scan(const std::string& name, const Index& index,
+                          const std::string& from, const std::string& to,
+                          size_t limit) const {
+    // Index and primary records from the same snapshot
+    auto snapshot = db_->MakeSnapshot();
+    auto it = snapshot->MakeIterator();
+
+    std::vector<Entry> entries;
+    for (it->Seek(from); it->Valid() && it->Key() < std::string_view{to} &&
+                         entries.size() < limit;
+         it->Next()) {
+      std::string key{it->Value()};
+      auto value =
+          Records::Decode(snapshot->TryGet(records_.WithNamespace(key)));
+      if (!value.has_value()) {
+        continue;  // Stale: record deleted
+      }
+      // Stale: record was rewritten with a different index key
+      auto index_key = index.extract(*value);
+      if (!index_key.has_value() ||
+          IndexPrefix(name) + *index_key + key != it->Key()) {
+        continue;
+      }
+      entries.emplace_back(std::move(key), std::move(*value));
+    }
+    return entries;
+  }
+
+ private:
+  db::IDatabase* db_;
+  Records records_;
+  std::string namespace_;
+  std::string index_namespace_;
+  std::map<std::string, Index> indexes_;
+};
+
+}  // namespace whirl::node::store
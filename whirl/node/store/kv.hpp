@@ -1,11 +1,13 @@
 #pragma once
 
 #include <whirl/node/db/database.hpp>
+#include <whirl/node/db/merge.hpp>
 
 #include <muesli/serialize.hpp>
 
 #include <fmt/core.h>
 
+#include <functional>
 #include <stdexcept>
 
 namespace whirl::node::store {
@@ -24,8 +26,7 @@ class KVStore {
   KVStore& operator=(const KVStore&) = delete;
 
   void Put(const std::string& key, const V& value) {
-    auto value_bytes = muesli::Serialize(value);
-    db_->Put(WithNamespace(key), value_bytes);
+    db_->Put(WithNamespace(key), Encode(value));
   }
 
   bool Has(const std::string& key) const {
@@ -34,12 +35,7 @@ class KVStore {
   }
 
   std::optional<V> TryGet(const std::string& key) const {
-    std::optional<std::string> value_bytes = db_->TryGet(WithNamespace(key));
-    if (value_bytes.has_value()) {
-      return muesli::Deserialize<V>(*value_bytes);
-    } else {
-      return std::nullopt;
-    }
+    return Decode(db_->TryGet(WithNamespace(key)));
   }
 
   V Get(const std::string& key) const {
@@ -60,15 +56,66 @@ class KVStore {
     db_->Delete(WithNamespace(key));
   }
 
- private:
-  static std::string MakeNamespace(const std::string& name) {
-    return fmt::format("kv:{}:", name);
+  // Blind update, requires merge operator for this store
+  // (see MakeMergeOperator) and db::MergingDatabase
+  template <typename Operand>
+  void Merge(const std::string& key, const Operand& operand) {
+    db_->Merge(WithNamespace(key), muesli::Serialize(operand));
   }
 
+  // Key prefix of the store with name `name`
+  static std::string Namespace(const std::string& name) {
+    return MakeNamespace(name);
+  }
+
+  // Record encoding, shared with stores writing records in batches
+  // (see IndexedKVStore)
+
   std::string WithNamespace(const std::string& user_key) const {
     return namespace_ + user_key;
   }
 
+  static std::string Encode(const V& value) {
+    return muesli::Serialize(value);
+  }
+
+  static std::optional<V> Decode(std::optional<std::string> bytes) {
+    if (bytes.has_value()) {
+      return muesli::Deserialize<V>(*bytes);
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  // Usage:
+  // operators.Register(KVStore<int64_t>::Namespace("counters"),
+  //   KVStore<int64_t>::MakeMergeOperator<int64_t>(
+  //     [](std::optional<int64_t> value, int64_t delta) {
+  //       return value.value_or(0) + delta;
+  //     }));
+  template <typename Operand>
+  static db::MergeOperator MakeMergeOperator(
+      std::function<V(std::optional<V>, const Operand&)> fold) {
+    return [fold = std::move(fold)](
+               db::KeyView /*key*/, std::optional<db::ValueView> existing,
+               const std::vector<db::ValueView>& operands) {
+      std::optional<V> value;
+      if (existing.has_value()) {
+        value = muesli::Deserialize<V>(std::string{*existing});
+      }
+      for (auto operand : operands) {
+        value = fold(std::move(value),
+                     muesli::Deserialize<Operand>(std::string{operand}));
+      }
+      return muesli::Serialize(*value);
+    };
+  }
+
+ private:
+  static std::string MakeNamespace(const std::string& name) {
+    return fmt::format("kv:{}:", name);
+  }
+
  private:
   db::IDatabase* db_;
   std::string namespace_;
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace whirl::node::store {
+
+// Order-preserving, self-delimiting encoding of index keys:
+// a < b <=> Encode(a) < Encode(b) (bytewise), no encoding is
+// a prefix of another one
+//
+// - Unsigned integers: big-endian
+// - Signed integers: sign bit flipped, big-endian
+// - Strings: \0 escaped as \0\xFF, terminated by \0\x01
+
+template <typename T>
+void AppendOrdered(std::string& output, const T& value) {
+  if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    auto bits = static_cast<U>(value);
+    if constexpr (std::is_signed_v<T>) {
+      bits ^= U{1} << (sizeof(U) * 8 - 1);
+    }
+    for (int shift = (sizeof(U) - 1) * 8; shift >= 0; shift -= 8) {
+      output.push_back(static_cast<char>((bits >> shift) & 0xFF));
+    }
+  } else {
+    static_assert(std::is_convertible_v<const T&, std::string_view>,
+                  "Unsupported index key type");
+    for (char c : std::string_view{value}) {
+      output.push_back(c);
+      if (c == '\0') {
+        output.push_back('\xFF');
+      }
+    }
+    output.push_back('\0');
+    output.push_back('\x01');
+  }
+}
+
+template <typename T>
+std::string EncodeOrdered(const T& value) {
+  std::string output;
+  AppendOrdered(output, value);
+  return output;
+}
+
+}  // namespace whirl::node::store
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <whirl/node/store/ordered.hpp>
+
+#include <whirl/node/db/database.hpp>
+#include <whirl/node/time/time_service.hpp>
+
+#include <muesli/serialize.hpp>
+
+#include <fmt/core.h>
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace whirl::node::store {
+
+// Persistent mapping: string -> V with per-key time-to-live
+//
+// Expired entries are invisible to reads immediately and removed
+// incrementally via ExpireSome, which walks a time-ordered index
+// instead of scanning the store:
+// ttl:{name}:{key} -> [expires at: u64][V]
+// ttl-index:{name}:{EncodeOrdered(expires at)}{key} -> key
+//
+// Writes are blind: index entries left by overwrites and deletes
+// are dropped lazily by ExpireSome
+//
+// Usage:
+//
+// TTLKVStore<Session> sessions{db, rt::TimeService(), "sessions"};
+// sessions.Put(id, session, /*ttl=*/10'000);
+// ...
+// // Background fiber
+// while (true) {
+//   sessions.ExpireSome(/*limit=*/128);
+//   rt::SleepFor(1'000);
+// }
+
+template <typename V>
+class TTLKVStore {
+  using Expiration = uint64_t;  // Wall time in jiffies
+  static const Expiration kNever = std::numeric_limits<Expiration>::max();
+  static const size_t kExpirationSize = sizeof(Expiration);
+
+ public:
+  TTLKVStore(db::IDatabase* db, time::ITimeService* clock,
+             const std::string& name)
+      : db_(db),
+        clock_(clock),
+        namespace_(fmt::format("ttl:{}:", name)),
+        index_namespace_(fmt::format("ttl-index:{}:", name)) {
+  }
+
+  // Non-copyable
+  TTLKVStore(const TTLKVStore&) = delete;
+  TTLKVStore& operator=(const TTLKVStore&) = delete;
+
+  // Without expiration
+  void Put(const std::string& key, const V& value) {
+    db_->Put(WithNamespace(key), Encode(kNever, value));
+  }
+
+  void Put(const std::string& key, const V& value, Jiffies ttl) {
+    PutUntil(key, value, clock_->WallTimeNow() + ttl);
+  }
+
+  void PutUntil(const std::string& key, const V& value,
+                time::WallTime expires_at) {
+    Expiration expiration = expires_at.ToJiffies().Count();
+
+    db::WriteBatch batch;
+    batch.Put(WithNamespace(key), Encode(expiration, value));
+    batch.Put(IndexKey(expiration, key), key);
+    db_->Write(std::move(batch));
+  }
+
+  bool Has(const std::string& key) const {
+    return TryGet(key).has_value();
+  }
+
+  std::optional<V> TryGet(const std::string& key) const {
+    auto bytes = db_->TryGet(WithNamespace(key));
+    if (!bytes.has_value() || IsExpired(ExpirationOf(*bytes))) {
+      return std::nullopt;
+    }
+    return muesli::Deserialize<V>(bytes->substr(kExpirationSize));
+  }
+
+  V Get(const std::string& key) const {
+    std::optional<V> existing_value = TryGet(key);
+    if (existing_value.has_value()) {
+      return *existing_value;
+    } else {
+      throw std::runtime_error(fmt::format(
+          "Key '{}' not found in local TTL storage", WithNamespace(key)));
+    }
+  }
+
+  V GetOr(const std::string& key, V or_value) const {
+    return TryGet(key).value_or(or_value);
+  }
+
+  void Delete(const std::string& key) {
+    db_->Delete(WithNamespace(key));
+  }
+
+  // Removes up to `limit` expired entries in a single write
+  // Returns number of index entries processed
+  size_t ExpireSome(size_t limit) {
+    auto now = Now();
+    auto end = index_namespace_ + EncodeOrdered(now + 1);
+
+    auto snapshot = db_->MakeSnapshot();
+    auto it = snapshot->MakeIterator();
+
+    db::WriteBatch batch;
+    size_t processed = 0;
+
+    for (it->Seek(index_namespace_);
+         it->Valid() && it->Key() < std::string_view{end} && processed < limit;
+         it->Next(), ++processed) {
+      batch.Delete(db::Key{it->Key()});
+
+      // Skip records overwritten since this entry was written
+      auto key = WithNamespace(std::string{it->Value()});
+      auto record = snapshot->TryGet(key);
+      if (record.has_value() && IsExpired(ExpirationOf(*record))) {
+        batch.Delete(std::move(key));
+      }
+    }
+
+    if (!batch.muts.empty()) {
+      db_->Write(std::move(batch));
+    }
+    return processed;
+  }
+
+  // Earliest expiration time in the index (possibly stale), for scheduling
+  // ExpireSome
+  std::optional<time::WallTime> NextExpiration() const {
+    auto it = db_->MakeSnapshot()->MakeIterator();
+    it->Seek(index_namespace_);
+    if (!it->Valid() || !it->Key().starts_with(index_namespace_)) {
+      return std::nullopt;
+    }
+    auto expiration = it->Key().substr(index_namespace_.size());
+    return time::WallTime{Jiffies{DecodeExpiration(expiration)}};
+  }
+
+ private:
+  std::string WithNamespace(const std::string& user_key) const {
+    return namespace_ + user_key;
+  }
+
+  std::string IndexKey(Expiration expiration, const std::string& key) const {
+    return index_namespace_ + EncodeOrdered(expiration) + key;
+  }
+
+  Expiration Now() const {
+    return clock_->WallTimeNow().ToJiffies().Count();
+  }
+
+  bool IsExpired(Expiration expiration) const {
+    return expiration != kNever && expiration <= Now();
+  }
+
+  static std::string Encode(Expiration expiration, const V& value) {
+    auto bytes = EncodeOrdered(expiration);
+    bytes.append(muesli::Serialize(value));
+    return bytes;
+  }
+
+  static Expiration DecodeExpiration(std::string_view bytes) {
+    Expiration expiration = 0;
+    for (size_t i = 0; i < kExpirationSize; ++i) {
+      expiration = (expiration << 8) | static_cast<uint8_t>(bytes[i]);
+    }
+    return expiration;
+  }
+
+  static Expiration ExpirationOf(const std::string& record) {
+    return DecodeExpiration(record);
+  }
+
+ private:
+  db::IDatabase* db_;
+  time::ITimeService* clock_;
+  std::string namespace_;
+  std::string index_namespace_;
+};
+
+}  // namespace whirl::node::store
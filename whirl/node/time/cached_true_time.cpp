@@ -0,0 +1,41 @@
+#include <whirl/node/time/cached_true_time.hpp>
+
+namespace whirl::node::time {
+
+void CachedTrueTime::Refresh() const {
+  if (EpochMode()) {
+    // Monotonic time is not needed in epoch mode
+    cached_.emplace(Entry{true_time_->Now(), MonotonicTime{0}});
+  } else {
+    cached_.emplace(Entry{true_time_->Now(), clocks_->MonotonicNow()});
+  }
+}
+
+TTInterval CachedTrueTime::FreshNow() const {
+  Refresh();
+  return cached_->interval;
+}
+
+TTInterval CachedTrueTime::Now() const {
+  if (!cached_.has_value()) {
+    Refresh();
+  }
+
+  if (EpochMode()) {
+    return cached_->interval;
+  }
+
+  Jiffies elapsed = clocks_->MonotonicNow() - cached_->taken_at;
+  if (elapsed > params_.max_staleness) {
+    Refresh();
+    return cached_->interval;
+  }
+
+  // Time only moves forward: `earliest` remains a lower bound
+  uint64_t drift = elapsed.Count() * params_.drift_ppm / 1'000'000 + 1;
+  TTInterval interval = cached_->interval;
+  interval.latest += elapsed + drift;
+  return interval;
+}
+
+}  // namespace whirl::node::time
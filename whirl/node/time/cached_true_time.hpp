@@ -0,0 +1,65 @@
+#pragma once
+
+#include <whirl/node/time/true_time_service.hpp>
+#include <whirl/node/time/time_service.hpp>
+
+#include <optional>
+
+namespace whirl::node::time {
+
+// TrueTime interval cached between reads
+//
+// Epoch mode (staleness = 0): interval is computed once and reused until
+// the engine calls NewEpoch, e.g. once per scheduler iteration
+//
+// Bounded staleness: cached interval is reused for `max_staleness` jiffies
+// of monotonic time; `latest` is widened by the elapsed time (plus drift),
+// so the interval still contains the absolute time
+//
+// Cached `earliest` does not advance: waits for `earliest` to pass
+// a timestamp use FreshNow
+
+class CachedTrueTime : public ITrueTimeService {
+ public:
+  struct Params {
+    // 0 - epoch mode
+    Jiffies max_staleness = 0;
+    // Monotonic clock drift bound, parts per million
+    uint64_t drift_ppm = 200;
+  };
+
+  CachedTrueTime(ITrueTimeService* true_time, ITimeService* clocks,
+                 Params params)
+      : true_time_(true_time), clocks_(clocks), params_(params) {
+  }
+
+  TTInterval Now() const override;
+
+  // Refreshes cached interval
+  TTInterval FreshNow() const override;
+
+  // Invalidates cached interval
+  void NewEpoch() {
+    cached_.reset();
+  }
+
+ private:
+  bool EpochMode() const {
+    return params_.max_staleness.Count() == 0;
+  }
+
+  void Refresh() const;
+
+ private:
+  ITrueTimeService* true_time_;
+  ITimeService* clocks_;
+  const Params params_;
+
+  struct Entry {
+    TTInterval interval;
+    MonotonicTime taken_at;
+  };
+  mutable std::optional<Entry> cached_;
+};
+
+}  // namespace whirl::node::time
@@ -6,8 +6,18 @@
 #include <whirl/node/time/wall_time.hpp>
 #include <whirl/node/time/monotonic_time.hpp>
 
+#include <functional>
+
 namespace whirl::node::time {
 
+// Timer that can be released before it fires
+struct CancellableTimer {
+  await::futures::Future<void> fired;
+  // Resolves `fired` with std::errc::operation_canceled and releases
+  // the engine timer, no-op if the timer has already fired
+  std::function<void()> cancel;
+};
+
 struct ITimeService : public await::time::ITimerService {
   virtual ~ITimeService() = default;
 
@@ -20,6 +30,9 @@ struct ITimeService : public await::time::ITimerService {
   // Timeouts and delays
   // Inherited from await::time::ITimerService
   // virtual await::futures::Future<void> After(await::time::Jiffies d) = 0;
+
+  // Cancellable timeout, see WheelTimerService
+  virtual CancellableTimer ArmTimer(Jiffies delay) = 0;
 };
 
 }  // namespace whirl::node::time
@@ -0,0 +1,224 @@
+#include <whirl/node/time/timer_wheel.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+
+namespace whirl::node::time {
+
+TimerWheel::TimerWheel(Jiffies now, Params params)
+    : now_(now.Count()), params_(params) {
+  WHEELS_VERIFY(params_.slack.Count() > 0, "Slack must be positive");
+  for (auto& level : heads_) {
+    level.fill(kNil);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Node pool
+
+uint32_t TimerWheel::AllocateNode() {
+  if (free_ != kNil) {
+    uint32_t index = free_;
+    free_ = nodes_[index].next;
+    return index;
+  }
+  nodes_.emplace_back();
+  return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void TimerWheel::FreeNode(uint32_t index) {
+  Node& node = nodes_[index];
+  node.armed = false;
+  node.expired = false;
+  ++node.generation;  // Invalidates outstanding handles
+  node.next = free_;
+  free_ = index;
+  --size_;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Slot lists
+
+void TimerWheel::Link(uint32_t index, size_t level, size_t slot) {
+  Node& node = nodes_[index];
+  node.level = static_cast<uint8_t>(level);
+  node.slot = static_cast<uint8_t>(slot);
+  node.prev = kNil;
+  node.next = heads_[level][slot];
+  if (node.next != kNil) {
+    nodes_[node.next].prev = index;
+  }
+  heads_[level][slot] = index;
+  occupied_[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::Unlink(uint32_t index) {
+  Node& node = nodes_[index];
+  if (node.prev != kNil) {
+    nodes_[node.prev].next = node.next;
+  } else {
+    heads_[node.level][node.slot] = node.next;
+  }
+  if (node.next != kNil) {
+    nodes_[node.next].prev = node.prev;
+  }
+  if (heads_[node.level][node.slot] == kNil) {
+    occupied_[node.level] &= ~(uint64_t{1} << node.slot);
+  }
+}
+
+// Timer goes to the level of the highest digit where its deadline
+// differs from `now_`
+void TimerWheel::Place(uint32_t index) {
+  uint64_t deadline = nodes_[index].deadline;
+
+  if (deadline <= now_) {
+    Link(index, 0, Digit(now_, 0));
+    return;
+  }
+
+  size_t high_bit = 63 - __builtin_clzll(deadline ^ now_);
+  size_t level = high_bit / kLevelBits;
+  Link(index, level, Digit(deadline, level));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TimerHandle TimerWheel::Arm(Jiffies deadline, ITimerHandler* handler) {
+  uint64_t at = deadline.Count();
+
+  // Coalescing
+  uint64_t slack = params_.slack.Count();
+  if (slack > 1 && at % slack != 0 && at < UINT64_MAX - slack) {
+    at += slack - at % slack;
+  }
+
+  uint32_t index = AllocateNode();
+  Node& node = nodes_[index];
+  node.deadline = at;
+  node.handler = handler;
+  node.armed = true;
+  ++size_;
+
+  Place(index);
+
+  return {index, node.generation};
+}
+
+bool TimerWheel::Cancel(TimerHandle handle) {
+  if (handle.index >= nodes_.size()) {
+    return false;
+  }
+  Node& node = nodes_[handle.index];
+  if (!node.armed || node.generation != handle.generation) {
+    return false;
+  }
+  if (!node.expired) {
+    Unlink(handle.index);
+  }
+  FreeNode(handle.index);
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+std::optional<uint64_t> TimerWheel::NextSlotStart(size_t level) const {
+  uint64_t mask = occupied_[level] & (~uint64_t{0} << Digit(now_, level));
+  if (mask == 0) {
+    return std::nullopt;
+  }
+  uint64_t slot = __builtin_ctzll(mask);
+
+  size_t prefix_shift = (level + 1) * kLevelBits;
+  uint64_t prefix =
+      prefix_shift >= 64 ? 0 : (now_ >> prefix_shift) << prefix_shift;
+  return prefix | (slot << (level * kLevelBits));
+}
+
+std::optional<uint64_t> TimerWheel::NextEvent() const {
+  std::optional<uint64_t> next;
+  for (size_t level = 0; level < kLevels; ++level) {
+    if (auto start = NextSlotStart(level)) {
+      next = next.has_value() ? std::min(*next, *start) : *start;
+    }
+  }
+  return next;
+}
+
+std::optional<Jiffies> TimerWheel::NextWakeup() const {
+  if (auto event = NextEvent()) {
+    return Jiffies{*event};
+  }
+  return std::nullopt;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void TimerWheel::Step() {
+  // Cascade: higher levels first, timers move closer to level 0
+  for (size_t level = kLevels - 1; level > 0; --level) {
+    size_t slot = Digit(now_, level);
+    uint32_t index = heads_[level][slot];
+    if (index == kNil) {
+      continue;
+    }
+    heads_[level][slot] = kNil;
+    occupied_[level] &= ~(uint64_t{1} << slot);
+
+    while (index != kNil) {
+      uint32_t next = nodes_[index].next;
+      Place(index);
+      index = next;
+    }
+  }
+
+  // Expire
+  size_t slot = Digit(now_, 0);
+  uint32_t index = heads_[0][slot];
+  heads_[0][slot] = kNil;
+  occupied_[0] &= ~(uint64_t{1} << slot);
+
+  while (index != kNil) {
+    Node& node = nodes_[index];
+    uint32_t next = node.next;
+    node.expired = true;
+    expired_.push_back({index, node.generation});
+    index = next;
+  }
+}
+
+size_t TimerWheel::Advance(Jiffies now) {
+  uint64_t target = now.Count();
+  size_t fired = 0;
+
+  while (true) {
+    auto event = NextEvent();
+    if (!event.has_value() || *event > target) {
+      break;
+    }
+    now_ = std::max(now_, *event);
+
+    Step();
+
+    // Batch: wheel is consistent, handlers may arm / cancel
+    for (TimerHandle handle : expired_) {
+      Node& node = nodes_[handle.index];
+      if (node.generation != handle.generation) {
+        continue;  // Cancelled by a handler earlier in the batch
+      }
+      ITimerHandler* handler = node.handler;
+      FreeNode(handle.index);
+      ++fired;
+      handler->OnExpired();
+    }
+    expired_.clear();
+  }
+
+  now_ = std::max(now_, target);
+  return fired;
+}
+
+}  // namespace whirl::node::time
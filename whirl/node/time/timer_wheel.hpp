@@ -0,0 +1,141 @@
+#pragma once
+
+#include <whirl/node/time/jiffies.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace whirl::node::time {
+
+//////////////////////////////////////////////////////////////////////
+
+struct ITimerHandler {
+  virtual ~ITimerHandler() = default;
+
+  virtual void OnExpired() = 0;
+};
+
+// Stale handles (timer already fired / cancelled) are detected
+struct TimerHandle {
+  uint32_t index;
+  uint32_t generation;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Hierarchical timing wheel
+// Varghese & Lauck, Hashed and Hierarchical Timing Wheels
+//
+// O(1) arm / cancel, expired timers are collected and fired in batches
+// Time is driven externally via Advance: by the simulator (jumping straight
+// to NextWakeup) or by a real-time engine tick
+//
+// Not thread-safe
+
+class TimerWheel {
+ public:
+  struct Params {
+    // Deadlines are rounded up to a multiple of `slack`,
+    // so timers armed close to each other fire in the same batch
+    Jiffies slack = 1;
+  };
+
+  explicit TimerWheel(Jiffies now, Params params);
+
+  explicit TimerWheel(Jiffies now) : TimerWheel(now, Params{}) {
+  }
+
+  // Non-copyable
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Absolute deadline, deadlines in the past fire on the next Advance
+  TimerHandle Arm(Jiffies deadline, ITimerHandler* handler);
+
+  TimerHandle ArmAfter(Jiffies delay, ITimerHandler* handler) {
+    return Arm(now_ + delay, handler);
+  }
+
+  // Returns false if timer has already fired or was cancelled
+  // Expired timer can still be cancelled until its handler is invoked
+  // (e.g. by the handler of another timer from the same batch)
+  bool Cancel(TimerHandle handle);
+
+  // Moves time forward to `now`, fires all timers with deadline <= now
+  // Handlers may arm and cancel timers
+  // Returns number of fired timers
+  size_t Advance(Jiffies now);
+
+  // Earliest time when Advance has work to do, O(levels)
+  // Lower bound for the earliest deadline, exact for timers due within
+  // the current level-0 span; otherwise Advance to it cascades timers closer,
+  // so the simulator reaches the deadline in at most `kLevels` wakeups
+  std::optional<Jiffies> NextWakeup() const;
+
+  Jiffies Now() const {
+    return now_;
+  }
+
+  size_t Size() const {
+    return size_;
+  }
+
+ private:
+  static constexpr size_t kLevelBits = 6;
+  static constexpr size_t kSlots = 1 << kLevelBits;
+  // Covers 64-bit deadlines
+  static constexpr size_t kLevels = (64 + kLevelBits - 1) / kLevelBits;
+
+  static constexpr uint32_t kNil = UINT32_MAX;
+
+  struct Node {
+    uint64_t deadline;
+    ITimerHandler* handler;
+    uint32_t prev;
+    uint32_t next;
+    uint32_t generation = 0;
+    uint8_t level;
+    uint8_t slot;
+    bool armed = false;
+    // Unlinked, waiting in expired_ for its handler to be invoked
+    bool expired = false;
+  };
+
+  uint32_t AllocateNode();
+  void FreeNode(uint32_t index);
+
+  void Place(uint32_t index);
+  void Link(uint32_t index, size_t level, size_t slot);
+  void Unlink(uint32_t index);
+
+  // Start of the first occupied slot at `level`, std::nullopt - empty
+  std::optional<uint64_t> NextSlotStart(size_t level) const;
+  std::optional<uint64_t> NextEvent() const;
+
+  // Processes slots starting at `now_`, collects expired timers
+  void Step();
+
+  static size_t Digit(uint64_t t, size_t level) {
+    return (t >> (level * kLevelBits)) & (kSlots - 1);
+  }
+
+ private:
+  uint64_t now_;
+  const Params params_;
+
+  std::vector<Node> nodes_;
+  uint32_t free_ = kNil;
+  size_t size_ = 0;
+
+  std::array<std::array<uint32_t, kSlots>, kLevels> heads_;
+  // Non-empty slots
+  std::array<uint64_t, kLevels> occupied_{};
+
+  // Reused between Advance calls
+  // Handles: timers cancelled after expiration are skipped
+  std::vector<TimerHandle> expired_;
+};
+
+}  // namespace whirl::node::time
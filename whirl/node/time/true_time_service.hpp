@@ -24,6 +24,11 @@ struct ITrueTimeService {
   // the absolute time during which TT.Now() was invoked
   virtual TTInterval Now() const = 0;
 
+  // Now() bypassing caches (see CachedTrueTime), for waits on `earliest`
+  virtual TTInterval FreshNow() const {
+    return Now();
+  }
+
   // True if `t` has definitely passed
   bool After(WallTime t) const {
     return Now().earliest > t;
@@ -0,0 +1,59 @@
+#include <whirl/node/time/wheel_timer_service.hpp>
+
+#include <await/futures/core/future.hpp>
+
+#include <system_error>
+
+namespace whirl::node::time {
+
+WheelTimerService::~WheelTimerService() {
+  for (auto& waiter : waiters_) {
+    wheel_->Cancel(waiter.handle);
+  }
+}
+
+WheelTimerService::Waiter* WheelTimerService::Arm(
+    Jiffies delay, await::futures::Promise<void> promise) {
+  waiters_.emplace_back(this, std::move(promise));
+  auto it = std::prev(waiters_.end());
+  it->self = it;
+  it->handle = wheel_->ArmAfter(delay, &*it);
+  return &*it;
+}
+
+await::futures::Future<void> WheelTimerService::After(
+    await::time::Jiffies delay) {
+  auto [future, promise] = await::futures::MakeContract<void>();
+  Arm(delay, std::move(promise));
+  return std::move(future);
+}
+
+CancellableTimer WheelTimerService::ArmTimer(Jiffies delay) {
+  auto [future, promise] = await::futures::MakeContract<void>();
+  Waiter* waiter = Arm(delay, std::move(promise));
+  TimerHandle handle = waiter->handle;
+
+  return {std::move(future), [this, waiter, handle]() {
+            Cancel(waiter, handle);
+          }};
+}
+
+void WheelTimerService::Cancel(Waiter* waiter, TimerHandle handle) {
+  // Stale handle: timer has already fired, waiter is gone
+  if (!wheel_->Cancel(handle)) {
+    return;
+  }
+  auto p = std::move(waiter->promise);
+  waiters_.erase(waiter->self);
+  std::move(p).SetError(std::make_error_code(std::errc::operation_canceled));
+}
+
+void WheelTimerService::Waiter::OnExpired() {
+  // Waiter is destroyed before the promise is completed:
+  // continuation may arm new timers
+  auto p = std::move(promise);
+  service->waiters_.erase(self);
+  std::move(p).SetValue();
+}
+
+}  // namespace whirl::node::time
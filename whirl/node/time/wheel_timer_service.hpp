@@ -0,0 +1,74 @@
+#pragma once
+
+#include <whirl/node/time/timer_wheel.hpp>
+#include <whirl/node/time/time_service.hpp>
+
+#include <await/time/timer_service.hpp>
+
+#include <list>
+
+namespace whirl::node::time {
+
+// await::time::ITimerService on top of TimerWheel:
+// After(d) arms a wheel timer that completes the returned future
+//
+// Usage in engine:
+//   WallTime WallTimeNow() override { ... }
+//   MonotonicTime MonotonicNow() override { ... }
+//   Future<void> After(await::time::Jiffies d) override {
+//     return timers_.After(d);
+//   }
+//   CancellableTimer ArmTimer(Jiffies d) override {
+//     return timers_.ArmTimer(d);
+//   }
+//
+// Engine drives the wheel (Advance / NextWakeup), wheel must outlive
+// the service
+// Futures of timers pending at destruction are never completed
+// Not thread-safe
+
+class WheelTimerService : public await::time::ITimerService {
+ public:
+  explicit WheelTimerService(TimerWheel* wheel) : wheel_(wheel) {
+  }
+
+  ~WheelTimerService();
+
+  // Non-copyable
+  WheelTimerService(const WheelTimerService&) = delete;
+  WheelTimerService& operator=(const WheelTimerService&) = delete;
+
+  await::futures::Future<void> After(await::time::Jiffies delay) override;
+
+  // `cancel` releases the wheel timer, must not be called after
+  // the service is destroyed
+  CancellableTimer ArmTimer(Jiffies delay);
+
+  size_t PendingCount() const {
+    return waiters_.size();
+  }
+
+ private:
+  struct Waiter : ITimerHandler {
+    WheelTimerService* service;
+    await::futures::Promise<void> promise;
+    std::list<Waiter>::iterator self;
+    TimerHandle handle;
+
+    Waiter(WheelTimerService* s, await::futures::Promise<void> p)
+        : service(s), promise(std::move(p)) {
+    }
+
+    void OnExpired() override;
+  };
+
+  Waiter* Arm(Jiffies delay, await::futures::Promise<void> promise);
+  void Cancel(Waiter* waiter, TimerHandle handle);
+
+ private:
+  TimerWheel* wheel_;
+  // Stable addresses: registered in the wheel as handlers
+  std::list<Waiter> waiters_;
+};
+
+}  // namespace whirl::node::time
@@ -4,22 +4,34 @@
 
 namespace whirl::node {
 
-static EngineRuntime engine_runtime_;
+static IRuntime& RuntimeNotSet() {
+  WHEELS_PANIC("Runtime not set");
+}
 
-static struct Initializer {
-  Initializer() {
-    engine_runtime_ = []() -> IRuntime& {
-      WHEELS_PANIC("Runtime not set");
-    };
-  }
-} initializer;
+// Per-thread binding: independent simulations may run
+// in parallel on different threads of the same process
+static thread_local EngineRuntime engine_runtime_ = RuntimeNotSet;
+static thread_local bool runtime_set_ = false;
 
 IRuntime& GetRuntime() {
   return engine_runtime_();
 }
 
+IRuntime* TryGetRuntime() {
+  if (!runtime_set_) {
+    return nullptr;
+  }
+  return &engine_runtime_();
+}
+
 void SetupRuntime(EngineRuntime getter) {
-  engine_runtime_ = getter;
+  engine_runtime_ = std::move(getter);
+  runtime_set_ = true;
+}
+
+void ResetRuntime() {
+  engine_runtime_ = RuntimeNotSet;
+  runtime_set_ = false;
 }
 
 }  // namespace whirl::node
@@ -9,10 +9,17 @@ namespace whirl::node {
 // Bridge connecting engine-agnostic node and concrete engine
 IRuntime& GetRuntime();
 
+// nullptr if runtime is not bound to the current thread
+IRuntime* TryGetRuntime();
+
 //////////////////////////////////////////////////////////////////////
 
 using EngineRuntime = std::function<IRuntime&()>;
 
+// Binds runtime to the current thread
 void SetupRuntime(EngineRuntime getter);
 
+// Unbinds runtime from the current thread
+void ResetRuntime();
+
 }  // namespace whirl::node
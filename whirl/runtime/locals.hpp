@@ -0,0 +1,23 @@
+#pragma once
+
+#include <whirl/node/random/stream.hpp>
+
+#include <cstddef>
+#include <optional>
+
+namespace whirl::node {
+
+// Node-local state of runtime shortcuts (rt::RandomStream, ...)
+// Owned by the runtime of a node: lifetime of locals == lifetime of
+// the node incarnation, engine resets them on node restart
+// (locals = {}) so that nothing survives a reboot
+
+struct RuntimeLocals {
+  // Seeded lazily from IRuntime::RandomService
+  std::optional<random::Stream> random;
+
+  // rt::Go / rt::GoBatch
+  size_t fibers_created = 0;
+};
+
+}  // namespace whirl::node
@@ -14,6 +14,8 @@
 
 #include <whirl/node/db/database.hpp>
 
+#include <whirl/node/memory/allocator.hpp>
+
 #include <whirl/node/cluster/discovery.hpp>
 
 #include <whirl/node/random/service.hpp>
@@ -22,6 +24,8 @@
 #include <whirl/node/misc/terminal.hpp>
 #include <whirl/node/misc/fault.hpp>
 
+#include <whirl/runtime/locals.hpp>
+
 namespace whirl::node {
 
 //////////////////////////////////////////////////////////////////////
@@ -47,6 +51,11 @@ struct IRuntime {
 
   virtual db::IDatabase* Database() = 0;
 
+  // Memory
+
+  // Attributes allocations to the current node
+  virtual memory::IAllocator* Allocator() = 0;
+
   // Net transport
 
   virtual commute::transport::ITransport* NetTransport() = 0;
@@ -74,6 +83,9 @@ struct IRuntime {
   // Misc
 
   virtual ITerminal* Terminal() = 0;
+
+  // State of runtime shortcuts, see RuntimeLocals
+  virtual RuntimeLocals* Locals() = 0;
 };
 
 }  // namespace whirl::node
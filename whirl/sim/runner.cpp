@@ -0,0 +1,193 @@
+#include <whirl/sim/runner.hpp>
+
+#include <whirl/runtime/access.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace whirl::sim {
+
+//////////////////////////////////////////////////////////////////////
+
+// Range of seeds owned by a single worker
+// Owner takes seeds from the front, thieves take the upper half
+
+class SeedRange {
+ public:
+  void Reset(Seed begin, Seed end) {
+    std::lock_guard guard(mutex_);
+    begin_ = begin;
+    end_ = end;
+  }
+
+  std::optional<Seed> TryTake() {
+    std::lock_guard guard(mutex_);
+    if (begin_ == end_) {
+      return std::nullopt;
+    }
+    return begin_++;
+  }
+
+  // Returns stolen range [begin, end), empty if nothing to steal
+  std::pair<Seed, Seed> StealHalf() {
+    std::lock_guard guard(mutex_);
+    Seed size = end_ - begin_;
+    if (size == 0) {
+      return {0, 0};
+    }
+    Seed middle = begin_ + size / 2;
+    Seed stolen_end = end_;
+    end_ = middle;
+    return {middle, stolen_end};
+  }
+
+ private:
+  std::mutex mutex_;
+  Seed begin_ = 0;
+  Seed end_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class ParallelRunner {
+ public:
+  ParallelRunner(const Simulation& simulation, RunnerParams params)
+      : simulation_(simulation),
+        params_(params),
+        ranges_(ThreadCount(params)) {
+  }
+
+  RunReport Run() {
+    Distribute();
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < ranges_.size(); ++i) {
+      workers.emplace_back([this, i]() {
+        Work(i);
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    RunReport report;
+    report.simulations = completed_.load();
+    report.failures = std::move(failures_);
+    report.elapsed_seconds =
+        std::chrono::duration<double>(elapsed).count();
+
+    std::sort(report.failures.begin(), report.failures.end(),
+              [](const Failure& lhs, const Failure& rhs) {
+                return lhs.seed < rhs.seed;
+              });
+
+    return report;
+  }
+
+ private:
+  static size_t ThreadCount(const RunnerParams& params) {
+    size_t threads = params.threads;
+    if (threads == 0) {
+      threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    // No idle workers
+    return std::max<size_t>(std::min(threads, params.count), 1);
+  }
+
+  void Distribute() {
+    const size_t workers = ranges_.size();
+    const Seed first = params_.first_seed;
+
+    for (size_t i = 0; i < workers; ++i) {
+      Seed begin = first + params_.count * i / workers;
+      Seed end = first + params_.count * (i + 1) / workers;
+      ranges_[i].Reset(begin, end);
+    }
+  }
+
+  void Work(size_t self) {
+    while (!stop_.load(std::memory_order_relaxed)) {
+      if (auto seed = ranges_[self].TryTake()) {
+        RunOne(*seed);
+      } else if (!TrySteal(self)) {
+        break;  // Ranges never grow, so all work is taken
+      }
+    }
+  }
+
+  bool TrySteal(size_t self) {
+    const size_t workers = ranges_.size();
+
+    for (size_t k = 1; k < workers; ++k) {
+      size_t victim = (self + k) % workers;
+      auto [begin, end] = ranges_[victim].StealHalf();
+      if (begin != end) {
+        ranges_[self].Reset(begin, end);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void RunOne(Seed seed) {
+    std::optional<std::string> failure;
+
+    try {
+      failure = simulation_(seed);
+    } catch (const std::exception& e) {
+      failure = e.what();
+    } catch (...) {
+      failure = "Unknown exception";
+    }
+
+    // Do not leak binding to the next simulation on this thread
+    node::ResetRuntime();
+
+    completed_.fetch_add(1, std::memory_order_relaxed);
+
+    if (failure.has_value()) {
+      ReportFailure(seed, std::move(*failure));
+    }
+  }
+
+  void ReportFailure(Seed seed, std::string what) {
+    {
+      std::lock_guard guard(failures_mutex_);
+      failures_.push_back({seed, std::move(what)});
+    }
+    if (params_.stop_on_failure) {
+      stop_.store(true);
+    }
+  }
+
+ private:
+  const Simulation& simulation_;
+  const RunnerParams params_;
+
+  std::vector<SeedRange> ranges_;
+
+  std::atomic<size_t> completed_{0};
+  std::atomic<bool> stop_{false};
+
+  std::mutex failures_mutex_;
+  std::vector<Failure> failures_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+RunReport RunSimulations(const Simulation& simulation, RunnerParams params) {
+  WHEELS_VERIFY(params.count > 0, "Empty seed range");
+  return ParallelRunner{simulation, params}.Run();
+}
+
+}  // namespace whirl::sim
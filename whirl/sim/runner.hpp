@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace whirl::sim {
+
+// Runs independent simulations (one per seed) on all cores
+
+using Seed = uint64_t;
+
+// Runs single simulation on the calling thread
+// Engine is expected to bind its runtime to this thread (node::SetupRuntime)
+// Returns std::nullopt on success, description of failure otherwise
+using Simulation = std::function<std::optional<std::string>(Seed seed)>;
+
+struct RunnerParams {
+  // Seeds: [first_seed, first_seed + count)
+  Seed first_seed = 0;
+  size_t count = 1;
+
+  // 0 - std::thread::hardware_concurrency()
+  size_t threads = 0;
+
+  // Do not start new simulations after first failure
+  bool stop_on_failure = false;
+};
+
+struct Failure {
+  Seed seed;
+  std::string what;
+};
+
+struct RunReport {
+  // Number of completed simulations
+  size_t simulations = 0;
+  // Sorted by seed
+  std::vector<Failure> failures;
+  double elapsed_seconds = 0;
+
+  bool Ok() const {
+    return failures.empty();
+  }
+
+  double SimulationsPerSecond() const {
+    if (elapsed_seconds == 0) {
+      return 0;
+    }
+    return simulations / elapsed_seconds;
+  }
+};
+
+// Seeds are split into contiguous per-thread ranges,
+// idle threads steal upper half of the range of a busy one
+RunReport RunSimulations(const Simulation& simulation, RunnerParams params);
+
+}  // namespace whirl::sim
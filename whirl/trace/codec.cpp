@@ -0,0 +1,220 @@
+#include <whirl/trace/writer.hpp>
+#include <whirl/trace/reader.hpp>
+
+#include <wheels/support/panic.hpp>
+
+#include <fmt/core.h>
+
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace whirl::trace {
+
+const char* ToString(EventKind kind) {
+  switch (kind) {
+    case EventKind::RandomNumber:
+      return "RandomNumber";
+    case EventKind::RandomWords:
+      return "RandomWords";
+    case EventKind::WallTime:
+      return "WallTime";
+    case EventKind::MonotonicTime:
+      return "MonotonicTime";
+    case EventKind::TrueTime:
+      return "TrueTime";
+    case EventKind::Guid:
+      return "Guid";
+    case EventKind::DbRead:
+      return "DbRead";
+    case EventKind::Message:
+      return "Message";
+    case EventKind::Disconnect:
+      return "Disconnect";
+    case EventKind::Connected:
+      return "Connected";
+    case EventKind::DbIterator:
+      return "DbIterator";
+    case EventKind::DbWrite:
+      return "DbWrite";
+    case EventKind::TimerFired:
+      return "TimerFired";
+  }
+  return "Unknown";
+}
+
+static uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TraceWriter::TraceWriter() {
+  for (size_t i = 0; i < 4; ++i) {
+    buffer_.push_back(static_cast<char>((kTraceMagic >> (8 * i)) & 0xFF));
+  }
+  buffer_.push_back(static_cast<char>(kTraceVersion));
+}
+
+void TraceWriter::Begin(EventKind kind) {
+  buffer_.push_back(static_cast<char>(kind));
+  ++events_;
+}
+
+void TraceWriter::PutVarint(uint64_t value) {
+  while (value >= 0x80) {
+    buffer_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  buffer_.push_back(static_cast<char>(value));
+}
+
+void TraceWriter::PutZigZag(int64_t value) {
+  PutVarint(ZigZag(value));
+}
+
+void TraceWriter::PutFixed64(uint64_t value) {
+  for (size_t i = 0; i < 8; ++i) {
+    buffer_.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void TraceWriter::PutBytes(std::string_view bytes) {
+  PutVarint(bytes.size());
+  buffer_.append(bytes);
+}
+
+void TraceWriter::PutClock(EventKind clock, uint64_t value) {
+  uint64_t& last =
+      (clock == EventKind::MonotonicTime) ? last_monotonic_ : last_wall_;
+  PutZigZag(static_cast<int64_t>(value - last));
+  last = value;
+}
+
+void TraceWriter::Save(const std::string& path) const {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(buffer_.data(), buffer_.size());
+  if (!file) {
+    WHEELS_PANIC(fmt::format("Cannot write trace to '{}'", path));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TraceReader::TraceReader(std::string_view bytes) : bytes_(bytes) {
+  uint32_t magic = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    magic |= uint32_t(GetByte()) << (8 * i);
+  }
+  uint8_t version = GetByte();
+
+  if (magic != kTraceMagic || version != kTraceVersion) {
+    WHEELS_PANIC("Not a trace or unsupported trace version");
+  }
+}
+
+void TraceReader::Truncated() const {
+  WHEELS_PANIC(
+      fmt::format("Trace is truncated after {} events", events_));
+}
+
+uint8_t TraceReader::GetByte() {
+  if (pos_ == bytes_.size()) {
+    Truncated();
+  }
+  return static_cast<uint8_t>(bytes_[pos_++]);
+}
+
+void TraceReader::Expect(EventKind kind) {
+  if (AtEnd()) {
+    WHEELS_PANIC(fmt::format(
+        "Replay diverged: trace ended after {} events, requested {}",
+        events_, ToString(kind)));
+  }
+  auto recorded = static_cast<EventKind>(GetByte());
+  if (recorded != kind) {
+    WHEELS_PANIC(fmt::format(
+        "Replay diverged at event {}: recorded {}, requested {}", events_,
+        ToString(recorded), ToString(kind)));
+  }
+  ++events_;
+}
+
+uint64_t TraceReader::GetVarint() {
+  uint64_t value = 0;
+  for (size_t shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = GetByte();
+    value |= uint64_t(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  Truncated();
+}
+
+int64_t TraceReader::GetZigZag() {
+  return UnZigZag(GetVarint());
+}
+
+uint64_t TraceReader::GetFixed64() {
+  uint64_t value = 0;
+  for (size_t i = 0; i < 8; ++i) {
+    value |= uint64_t(GetByte()) << (8 * i);
+  }
+  return value;
+}
+
+std::string_view TraceReader::GetBytes() {
+  uint64_t size = GetVarint();
+  if (size > bytes_.size() - pos_) {
+    Truncated();
+  }
+  auto bytes = bytes_.substr(pos_, size);
+  pos_ += size;
+  return bytes;
+}
+
+uint64_t TraceReader::GetClock(EventKind clock) {
+  uint64_t& last =
+      (clock == EventKind::MonotonicTime) ? last_monotonic_ : last_wall_;
+  last += static_cast<uint64_t>(GetZigZag());
+  return last;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+MappedTrace::MappedTrace(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    WHEELS_PANIC(fmt::format("Cannot open trace '{}'", path));
+  }
+
+  struct stat st;
+  ::fstat(fd, &st);
+  size_ = static_cast<size_t>(st.st_size);
+
+  if (size_ > 0) {
+    data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+
+  if (data_ == MAP_FAILED) {
+    WHEELS_PANIC(fmt::format("Cannot map trace '{}'", path));
+  }
+}
+
+MappedTrace::~MappedTrace() {
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+}
+
+}  // namespace whirl::trace
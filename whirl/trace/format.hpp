@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+namespace whirl::trace {
+
+// Binary trace of nondeterministic inputs observed by a node
+//
+// Layout: [magic: u32][version: u8] event*
+// Event: [kind: u8] payload
+//
+// Payloads:
+// - RandomNumber: varint
+// - RandomWords: varint count, count x u64
+// - WallTime / MonotonicTime: zigzag varint delta from the previous
+//   read of the same clock
+// - TrueTime: zigzag varint delta of `earliest` from the previous
+//   wall clock read, varint (latest - earliest)
+// - Guid: u64 hi, u64 lo
+// - DbRead: u8 found, [varint size, bytes]
+// - Message: varint handler id, varint size, peer, varint size, message
+// - Disconnect: varint handler id, varint size, peer
+// - Connected: varint (0 / 1)
+// - DbIterator: varint op, [varint size, seek target],
+//   varint valid, [varint size, key, varint size, value]
+// - DbWrite: u64 fingerprint of mutations
+// - TimerFired: varint timer id, varint ok
+//
+// Integers are little-endian
+
+static const uint32_t kTraceMagic = 0x52544857;  // "WHTR"
+static const uint8_t kTraceVersion = 3;
+
+enum class EventKind : uint8_t {
+  RandomNumber = 1,
+  RandomWords = 2,
+  WallTime = 3,
+  MonotonicTime = 4,
+  TrueTime = 5,
+  Guid = 6,
+  DbRead = 7,
+  // Inbound transport events, see trace/transport.hpp
+  Message = 8,
+  Disconnect = 9,
+  Connected = 10,
+  DbIterator = 11,
+  DbWrite = 12,
+  TimerFired = 13,
+};
+
+const char* ToString(EventKind kind);
+
+}  // namespace whirl::trace
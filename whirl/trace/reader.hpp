@@ -0,0 +1,76 @@
+#pragma once
+
+#include <whirl/trace/format.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace whirl::trace {
+
+// Sequential reader over trace bytes (e.g. mapped file)
+// Panics on divergence: replayed node requested an input
+// that differs from the recorded one
+
+class TraceReader {
+ public:
+  explicit TraceReader(std::string_view bytes);
+
+  void Expect(EventKind kind);
+
+  // Kind of the next event, does not consume it
+  bool NextIs(EventKind kind) const {
+    return !AtEnd() && static_cast<EventKind>(bytes_[pos_]) == kind;
+  }
+
+  uint64_t GetVarint();
+  int64_t GetZigZag();
+  uint64_t GetFixed64();
+  std::string_view GetBytes();
+
+  uint64_t GetClock(EventKind clock);
+
+  bool AtEnd() const {
+    return pos_ == bytes_.size();
+  }
+
+  size_t EventCount() const {
+    return events_;
+  }
+
+ private:
+  uint8_t GetByte();
+  [[noreturn]] void Truncated() const;
+
+ private:
+  std::string_view bytes_;
+  size_t pos_ = 0;
+  size_t events_ = 0;
+  uint64_t last_wall_ = 0;
+  uint64_t last_monotonic_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Read-only memory mapping of a trace file
+
+class MappedTrace {
+ public:
+  explicit MappedTrace(const std::string& path);
+  ~MappedTrace();
+
+  // Non-copyable
+  MappedTrace(const MappedTrace&) = delete;
+  MappedTrace& operator=(const MappedTrace&) = delete;
+
+  std::string_view Bytes() const {
+    return {static_cast<const char*>(data_), size_};
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace whirl::trace
@@ -0,0 +1,662 @@
+#include <whirl/trace/runtime.hpp>
+
+#include <whirl/trace/tape.hpp>
+#include <whirl/trace/transport.hpp>
+
+#include <await/futures/core/future.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <fmt/core.h>
+
+#include <map>
+#include <optional>
+#include <system_error>
+
+namespace whirl::trace {
+
+using namespace node;
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////
+
+class TracingTimeService : public time::ITimeService {
+ public:
+  TracingTimeService(time::ITimeService* inner, Tape* tape)
+      : inner_(inner), tape_(tape) {
+  }
+
+  time::WallTime WallTimeNow() override {
+    return Clock(EventKind::WallTime, [this]() {
+      return inner_->WallTimeNow().ToJiffies();
+    });
+  }
+
+  time::MonotonicTime MonotonicNow() override {
+    return Clock(EventKind::MonotonicTime, [this]() {
+      return inner_->MonotonicNow().ToJiffies();
+    });
+  }
+
+  // Timer firings are inputs: recorded in delivery order,
+  // replayed by DeliverNext, engine timers are not used in replay
+
+  await::futures::Future<void> After(await::time::Jiffies d) override {
+    uint64_t id = next_timer_++;
+    if (tape_->Replaying()) {
+      return Park(id);
+    }
+    return Recorded(id, inner_->After(d));
+  }
+
+  time::CancellableTimer ArmTimer(Jiffies delay) override {
+    uint64_t id = next_timer_++;
+    if (tape_->Replaying()) {
+      return {Park(id), [this, id]() {
+                CancelReplayed(id);
+              }};
+    }
+    auto timer = inner_->ArmTimer(delay);
+    return {Recorded(id, std::move(timer.fired)), std::move(timer.cancel)};
+  }
+
+  // Replay: fires the next recorded timer if it is the next event
+  bool DeliverNext() {
+    if (!tape_->Reader().NextIs(EventKind::TimerFired)) {
+      return false;
+    }
+    Fire(std::nullopt);
+    return true;
+  }
+
+ private:
+  await::futures::Future<void> Recorded(uint64_t id,
+                                        await::futures::Future<void> fired) {
+    auto [future, promise] = await::futures::MakeContract<void>();
+
+    std::move(fired).Subscribe([tape = tape_, id, promise = std::move(promise)](
+                                   wheels::Result<void> result) mutable {
+      auto& writer = tape->Writer();
+      writer.Begin(EventKind::TimerFired);
+      writer.PutVarint(id);
+      writer.PutVarint(result.IsOk() ? 1 : 0);
+      std::move(promise).Set(std::move(result));
+    });
+
+    return std::move(future);
+  }
+
+  await::futures::Future<void> Park(uint64_t id) {
+    auto [future, promise] = await::futures::MakeContract<void>();
+    pending_.emplace(id, std::move(promise));
+    return std::move(future);
+  }
+
+  void Fire(std::optional<uint64_t> expected) {
+    auto& reader = tape_->Reader();
+    reader.Expect(EventKind::TimerFired);
+    uint64_t id = reader.GetVarint();
+    bool ok = reader.GetVarint() != 0;
+
+    auto it = pending_.find(id);
+    WHEELS_VERIFY(it != pending_.end() && expected.value_or(id) == id,
+                  fmt::format("Replay diverged: timer {} is not expected "
+                              "to fire",
+                              id));
+    auto promise = std::move(it->second);
+    pending_.erase(it);
+
+    if (ok) {
+      std::move(promise).SetValue();
+    } else {
+      std::move(promise).SetError(
+          std::make_error_code(std::errc::operation_canceled));
+    }
+  }
+
+  void CancelReplayed(uint64_t id) {
+    // Cancellation of a pending timer resolved it synchronously
+    // in the recording
+    if (pending_.count(id) > 0) {
+      Fire(id);
+    }
+  }
+
+ private:
+  template <typename F>
+  Jiffies Clock(EventKind kind, F read) {
+    if (tape_->Replaying()) {
+      tape_->Reader().Expect(kind);
+      return tape_->Reader().GetClock(kind);
+    } else {
+      Jiffies now = read();
+      tape_->Writer().Begin(kind);
+      tape_->Writer().PutClock(kind, now.Count());
+      return now;
+    }
+  }
+
+ private:
+  time::ITimeService* inner_;
+  Tape* tape_;
+
+  uint64_t next_timer_ = 0;
+  // Replay
+  std::map<uint64_t, await::futures::Promise<void>> pending_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class TracingTrueTime : public time::ITrueTimeService {
+ public:
+  TracingTrueTime(time::ITrueTimeService* inner, Tape* tape)
+      : inner_(inner), tape_(tape) {
+  }
+
+  time::TTInterval Now() const override {
+    return Interval([this]() {
+      return inner_->Now();
+    });
+  }
+
+  time::TTInterval FreshNow() const override {
+    return Interval([this]() {
+      return inner_->FreshNow();
+    });
+  }
+
+ private:
+  template <typename F>
+  time::TTInterval Interval(F read) const {
+    if (tape_->Replaying()) {
+      auto& reader = tape_->Reader();
+      reader.Expect(EventKind::TrueTime);
+      Jiffies earliest = reader.GetClock(EventKind::WallTime);
+      Jiffies width = reader.GetVarint();
+      return {earliest, earliest + width};
+    } else {
+      auto interval = read();
+      auto& writer = tape_->Writer();
+      writer.Begin(EventKind::TrueTime);
+      writer.PutClock(EventKind::WallTime,
+                      interval.earliest.ToJiffies().Count());
+      writer.PutVarint((interval.latest - interval.earliest).Count());
+      return interval;
+    }
+  }
+
+ private:
+  time::ITrueTimeService* inner_;
+  Tape* tape_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class TracingRandomService : public random::IRandomService {
+ public:
+  TracingRandomService(random::IRandomService* inner, Tape* tape)
+      : inner_(inner), tape_(tape) {
+  }
+
+  uint64_t GenerateNumber(uint64_t bound) override {
+    if (tape_->Replaying()) {
+      tape_->Reader().Expect(EventKind::RandomNumber);
+      uint64_t number = tape_->Reader().GetVarint();
+      WHEELS_VERIFY(number < bound, "Replay diverged: random bound changed");
+      return number;
+    } else {
+      uint64_t number = inner_->GenerateNumber(bound);
+      tape_->Writer().Begin(EventKind::RandomNumber);
+      tape_->Writer().PutVarint(number);
+      return number;
+    }
+  }
+
+  void GenerateWords(uint64_t* words, size_t count) override {
+    if (tape_->Replaying()) {
+      auto& reader = tape_->Reader();
+      reader.Expect(EventKind::RandomWords);
+      WHEELS_VERIFY(reader.GetVarint() == count,
+                    "Replay diverged: random words count changed");
+      for (size_t i = 0; i < count; ++i) {
+        words[i] = reader.GetFixed64();
+      }
+    } else {
+      inner_->GenerateWords(words, count);
+      auto& writer = tape_->Writer();
+      writer.Begin(EventKind::RandomWords);
+      writer.PutVarint(count);
+      for (size_t i = 0; i < count; ++i) {
+        writer.PutFixed64(words[i]);
+      }
+    }
+  }
+
+ private:
+  random::IRandomService* inner_;
+  Tape* tape_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class TracingGuidGenerator : public guids::IGuidGenerator {
+ public:
+  TracingGuidGenerator(guids::IGuidGenerator* inner, Tape* tape)
+      : inner_(inner), tape_(tape) {
+  }
+
+  guids::Guid Generate() override {
+    if (tape_->Replaying()) {
+      auto& reader = tape_->Reader();
+      reader.Expect(EventKind::Guid);
+      guids::Guid guid;
+      guid.hi = reader.GetFixed64();
+      guid.lo = reader.GetFixed64();
+      return guid;
+    } else {
+      auto guid = inner_->Generate();
+      auto& writer = tape_->Writer();
+      writer.Begin(EventKind::Guid);
+      writer.PutFixed64(guid.hi);
+      writer.PutFixed64(guid.lo);
+      return guid;
+    }
+  }
+
+ private:
+  guids::IGuidGenerator* inner_;
+  Tape* tape_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Replay never touches the inner database: its contents differ
+// from the recorded run
+// Point reads and iterator steps are served from the tape,
+// writes are checked against recorded fingerprints
+
+template <typename Read>
+std::optional<db::Value> TraceRead(Tape* tape, Read read) {
+  if (tape->Replaying()) {
+    auto& reader = tape->Reader();
+    reader.Expect(EventKind::DbRead);
+    if (reader.GetVarint() == 0) {
+      return std::nullopt;
+    }
+    return db::Value{reader.GetBytes()};
+  } else {
+    auto value = read();
+    auto& writer = tape->Writer();
+    writer.Begin(EventKind::DbRead);
+    writer.PutVarint(value.has_value() ? 1 : 0);
+    if (value.has_value()) {
+      writer.PutBytes(*value);
+    }
+    return value;
+  }
+}
+
+// FNV-1a over mutations
+class Fingerprint {
+ public:
+  void Add(const db::Mutation& mut) {
+    AddInt(static_cast<uint64_t>(mut.type));
+    AddBytes(mut.key);
+    if (mut.value.has_value()) {
+      AddBytes(*mut.value);
+    }
+  }
+
+  uint64_t Digest() const {
+    return hash_;
+  }
+
+ private:
+  void AddInt(uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) {
+      AddByte(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+
+  void AddBytes(std::string_view bytes) {
+    AddInt(bytes.size());
+    for (char c : bytes) {
+      AddByte(static_cast<uint8_t>(c));
+    }
+  }
+
+  void AddByte(uint8_t byte) {
+    hash_ = (hash_ ^ byte) * 0x100000001b3;
+  }
+
+ private:
+  uint64_t hash_ = 0xcbf29ce484222325;
+};
+
+template <typename Apply>
+void TraceWrite(Tape* tape, const db::WriteBatch& batch, Apply apply) {
+  Fingerprint fingerprint;
+  for (const auto& mut : batch.muts) {
+    fingerprint.Add(mut);
+  }
+
+  if (tape->Replaying()) {
+    auto& reader = tape->Reader();
+    reader.Expect(EventKind::DbWrite);
+    WHEELS_VERIFY(reader.GetFixed64() == fingerprint.Digest(),
+                  "Replay diverged: database write differs");
+  } else {
+    auto& writer = tape->Writer();
+    writer.Begin(EventKind::DbWrite);
+    writer.PutFixed64(fingerprint.Digest());
+    apply();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Position after every move is recorded: [op][target]? [valid][key, value]?
+
+class TracingIterator : public db::IIterator {
+  enum Op : uint8_t {
+    kSeek = 0,
+    kSeekToFirst = 1,
+    kSeekToLast = 2,
+    kNext = 3,
+    kPrev = 4,
+  };
+
+ public:
+  // `inner` is nullptr in replay
+  TracingIterator(db::IIteratorPtr inner, Tape* tape)
+      : inner_(std::move(inner)), tape_(tape) {
+  }
+
+  bool Valid() const override {
+    return valid_;
+  }
+
+  db::KeyView Key() const override {
+    return key_;
+  }
+
+  db::ValueView Value() const override {
+    return value_;
+  }
+
+  void Seek(const db::Key& target) override {
+    Step(kSeek, target, [&]() {
+      inner_->Seek(target);
+    });
+  }
+
+  void SeekToFirst() override {
+    Step(kSeekToFirst, {}, [&]() {
+      inner_->SeekToFirst();
+    });
+  }
+
+  void SeekToLast() override {
+    Step(kSeekToLast, {}, [&]() {
+      inner_->SeekToLast();
+    });
+  }
+
+  void Next() override {
+    Step(kNext, {}, [&]() {
+      inner_->Next();
+    });
+  }
+
+  void Prev() override {
+    Step(kPrev, {}, [&]() {
+      inner_->Prev();
+    });
+  }
+
+ private:
+  template <typename Move>
+  void Step(Op op, std::string_view target, Move move) {
+    if (tape_->Replaying()) {
+      auto& reader = tape_->Reader();
+      reader.Expect(EventKind::DbIterator);
+      bool same_op = reader.GetVarint() == op;
+      WHEELS_VERIFY(same_op && (op != kSeek || reader.GetBytes() == target),
+                    "Replay diverged: iterator moved differently");
+      // Views into the trace
+      valid_ = reader.GetVarint() != 0;
+      if (valid_) {
+        key_ = reader.GetBytes();
+        value_ = reader.GetBytes();
+      }
+    } else {
+      move();
+      valid_ = inner_->Valid();
+      if (valid_) {
+        key_ = inner_->Key();
+        value_ = inner_->Value();
+      }
+
+      auto& writer = tape_->Writer();
+      writer.Begin(EventKind::DbIterator);
+      writer.PutVarint(op);
+      if (op == kSeek) {
+        writer.PutBytes(target);
+      }
+      writer.PutVarint(valid_ ? 1 : 0);
+      if (valid_) {
+        writer.PutBytes(key_);
+        writer.PutBytes(value_);
+      }
+    }
+  }
+
+ private:
+  db::IIteratorPtr inner_;
+  Tape* tape_;
+
+  bool valid_ = false;
+  std::string_view key_;
+  std::string_view value_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class TracingSnapshot : public db::ISnapshot {
+ public:
+  // `inner` is nullptr in replay
+  TracingSnapshot(db::ISnapshotPtr inner, Tape* tape)
+      : inner_(std::move(inner)), tape_(tape) {
+  }
+
+  std::optional<db::Value> TryGet(const db::Key& key) const override {
+    return TraceRead(tape_, [&]() {
+      return inner_->TryGet(key);
+    });
+  }
+
+  db::IIteratorPtr MakeIterator() override {
+    return std::make_shared<TracingIterator>(
+        inner_ ? inner_->MakeIterator() : nullptr, tape_);
+  }
+
+ private:
+  db::ISnapshotPtr inner_;
+  Tape* tape_;
+};
+
+class TracingDatabase : public db::IDatabase {
+ public:
+  TracingDatabase(db::IDatabase* inner, Tape* tape)
+      : inner_(inner), tape_(tape) {
+  }
+
+  void Open(const std::string& directory) override {
+    if (!tape_->Replaying()) {
+      inner_->Open(directory);
+    }
+  }
+
+  void Put(const db::Key& key, const db::Value& value) override {
+    db::WriteBatch batch;
+    batch.Put(key, value);
+    TraceWrite(tape_, batch, [&]() {
+      inner_->Put(key, value);
+    });
+  }
+
+  std::optional<db::Value> TryGet(const db::Key& key) const override {
+    return TraceRead(tape_, [&]() {
+      return inner_->TryGet(key);
+    });
+  }
+
+  void Delete(const db::Key& key) override {
+    db::WriteBatch batch;
+    batch.Delete(key);
+    TraceWrite(tape_, batch, [&]() {
+      inner_->Delete(key);
+    });
+  }
+
+  void Merge(const db::Key& key, const db::Value& operand) override {
+    db::WriteBatch batch;
+    batch.Merge(key, operand);
+    TraceWrite(tape_, batch, [&]() {
+      inner_->Merge(key, operand);
+    });
+  }
+
+  bool SupportsMerge() const override {
+    return inner_->SupportsMerge();
+  }
+
+  void Write(db::WriteBatch batch) override {
+    // Also in replay: recorded run would have failed here
+    db::VerifyMergeSupport(*inner_, batch);
+    TraceWrite(tape_, batch, [&]() {
+      inner_->Write(std::move(batch));
+    });
+  }
+
+  db::ISnapshotPtr MakeSnapshot() override {
+    if (tape_->Replaying()) {
+      return std::make_shared<TracingSnapshot>(nullptr, tape_);
+    }
+    return std::make_shared<TracingSnapshot>(inner_->MakeSnapshot(), tape_);
+  }
+
+ private:
+  db::IDatabase* inner_;
+  Tape* tape_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class TracingRuntime : public IReplayRuntime {
+ public:
+  TracingRuntime(IRuntime* inner, Tape tape)
+      : inner_(inner),
+        tape_(tape),
+        time_(inner->TimeService(), &tape_),
+        true_time_(inner->TrueTime(), &tape_),
+        random_(inner->RandomService(), &tape_),
+        guids_(inner->GuidGenerator(), &tape_),
+        db_(inner->Database(), &tape_),
+        transport_(inner->NetTransport(), &tape_) {
+  }
+
+  bool DeliverNext() override {
+    return time_.DeliverNext() || transport_.DeliverNext();
+  }
+
+  await::executors::IExecutor* Executor() override {
+    return inner_->Executor();
+  }
+
+  await::fibers::IFiberManager* FiberManager() override {
+    return inner_->FiberManager();
+  }
+
+  time::ITimeService* TimeService() override {
+    return &time_;
+  }
+
+  time::ITrueTimeService* TrueTime() override {
+    return &true_time_;
+  }
+
+  persist::fs::IFileSystem* FileSystem() override {
+    return inner_->FileSystem();
+  }
+
+  db::IDatabase* Database() override {
+    return &db_;
+  }
+
+  memory::IAllocator* Allocator() override {
+    return inner_->Allocator();
+  }
+
+  commute::transport::ITransport* NetTransport() override {
+    return &transport_;
+  }
+
+  cluster::IDiscoveryService* DiscoveryService() override {
+    return inner_->DiscoveryService();
+  }
+
+  timber::ILogBackend* LoggerBackend() override {
+    return inner_->LoggerBackend();
+  }
+
+  random::IRandomService* RandomService() override {
+    return &random_;
+  }
+
+  guids::IGuidGenerator* GuidGenerator() override {
+    return &guids_;
+  }
+
+  cfg::IConfig* Config() override {
+    return inner_->Config();
+  }
+
+  ITerminal* Terminal() override {
+    return inner_->Terminal();
+  }
+
+  // Own locals: random stream is seeded through the traced service
+  RuntimeLocals* Locals() override {
+    return &locals_;
+  }
+
+ private:
+  IRuntime* inner_;
+  Tape tape_;
+  RuntimeLocals locals_;
+
+  TracingTimeService time_;
+  TracingTrueTime true_time_;
+  TracingRandomService random_;
+  TracingGuidGenerator guids_;
+  TracingDatabase db_;
+  TracingTransport transport_;
+};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<IRuntime> MakeRecordingRuntime(IRuntime* inner,
+                                               TraceWriter* writer) {
+  return std::make_unique<TracingRuntime>(inner, Tape{writer});
+}
+
+std::unique_ptr<IReplayRuntime> MakeReplayRuntime(IRuntime* inner,
+                                                  TraceReader* reader) {
+  return std::make_unique<TracingRuntime>(inner, Tape{reader});
+}
+
+}  // namespace whirl::trace
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <whirl/runtime/runtime.hpp>
+
+#include <whirl/trace/writer.hpp>
+#include <whirl/trace/reader.hpp>
+
+#include <memory>
+
+namespace whirl::trace {
+
+// Record / replay of a single node execution
+//
+// Recorded inputs: wall / monotonic clocks, TrueTime, random numbers,
+// guids, database reads (point reads and iterator steps, including
+// snapshots), timer firings and inbound messages in delivery order
+// (see trace/transport.hpp)
+// Database writes are recorded as fingerprints: replay checks them
+//
+// Replay does not use the network, timers and database of `inner`:
+// single node is replayed without the rest of the cluster
+// Executor, fibers, file system, logging and config are forwarded
+// to `inner` in both modes
+//
+// Usage:
+//   trace::TraceWriter writer;
+//   auto recording = trace::MakeRecordingRuntime(&engine_runtime, &writer);
+//   node::SetupRuntime([&]() -> node::IRuntime& { return *recording; });
+//   ...
+//   writer.Save("node.trace");
+//
+//   trace::MappedTrace file("node.trace");
+//   trace::TraceReader reader(file.Bytes());
+//   auto replay = trace::MakeReplayRuntime(&engine_runtime, &reader);
+//   node::SetupRuntime([&]() -> node::IRuntime& { return *replay; });
+//   // Start node, then
+//   while (!reader.AtEnd()) {
+//     // Run ready tasks of engine_runtime
+//     if (!replay->DeliverNext()) { ... }  // Next input is not a delivery
+//   }
+
+// Forwards to `inner`, appends every observed input to `writer`
+std::unique_ptr<node::IRuntime> MakeRecordingRuntime(node::IRuntime* inner,
+                                                     TraceWriter* writer);
+
+struct IReplayRuntime : node::IRuntime {
+  // Delivers the next recorded timer firing or inbound message
+  // (or disconnect) if it is the next event on the tape,
+  // returns false otherwise
+  // Call when the node is idle: recorded deliveries happened between
+  // node steps
+  virtual bool DeliverNext() = 0;
+};
+
+// Serves inputs from `reader` instead of `inner`
+// Panics (with event index) if node diverges from the recorded execution
+std::unique_ptr<IReplayRuntime> MakeReplayRuntime(node::IRuntime* inner,
+                                                  TraceReader* reader);
+
+}  // namespace whirl::trace
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <whirl/trace/writer.hpp>
+#include <whirl/trace/reader.hpp>
+
+namespace whirl::trace {
+
+// Either records to writer or replays from reader
+
+class Tape {
+ public:
+  explicit Tape(TraceWriter* writer) : writer_(writer) {
+  }
+
+  explicit Tape(TraceReader* reader) : reader_(reader) {
+  }
+
+  bool Replaying() const {
+    return reader_ != nullptr;
+  }
+
+  TraceWriter& Writer() {
+    return *writer_;
+  }
+
+  TraceReader& Reader() {
+    return *reader_;
+  }
+
+ private:
+  TraceWriter* writer_ = nullptr;
+  TraceReader* reader_ = nullptr;
+};
+
+}  // namespace whirl::trace
@@ -0,0 +1,189 @@
+#include <whirl/trace/transport.hpp>
+
+#include <wheels/support/assert.hpp>
+
+#include <fmt/core.h>
+
+namespace whirl::trace {
+
+using commute::transport::IHandler;
+using commute::transport::IHandlerPtr;
+using commute::transport::IServer;
+using commute::transport::IServerPtr;
+using commute::transport::ISocket;
+using commute::transport::ISocketPtr;
+using commute::transport::Message;
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////
+
+// Connection state is an input: traced
+// Replay: socket without network, sends are dropped
+
+class TracingSocket : public ISocket {
+ public:
+  // Recording
+  TracingSocket(ISocketPtr inner, Tape* tape)
+      : inner_(std::move(inner)), peer_(inner_->Peer()), tape_(tape) {
+  }
+
+  // Replay
+  TracingSocket(std::string peer, Tape* tape)
+      : peer_(std::move(peer)), tape_(tape) {
+  }
+
+  const std::string& Peer() const override {
+    return peer_;
+  }
+
+  void Send(const Message& message) override {
+    if (inner_) {
+      inner_->Send(message);
+    }
+  }
+
+  void Close() override {
+    if (inner_) {
+      inner_->Close();
+    }
+  }
+
+  bool IsConnected() const override {
+    if (tape_->Replaying()) {
+      auto& reader = tape_->Reader();
+      reader.Expect(EventKind::Connected);
+      return reader.GetVarint() != 0;
+    } else {
+      bool connected = inner_->IsConnected();
+      auto& writer = tape_->Writer();
+      writer.Begin(EventKind::Connected);
+      writer.PutVarint(connected ? 1 : 0);
+      return connected;
+    }
+  }
+
+ private:
+  ISocketPtr inner_;
+  std::string peer_;
+  Tape* tape_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Recording: appends deliveries to the tape before forwarding
+
+class TracingHandler : public IHandler {
+ public:
+  TracingHandler(IHandlerPtr inner, size_t id, Tape* tape)
+      : inner_(std::move(inner)), id_(id), tape_(tape) {
+  }
+
+  void HandleMessage(const Message& message, ISocketPtr back) override {
+    auto& writer = tape_->Writer();
+    writer.Begin(EventKind::Message);
+    writer.PutVarint(id_);
+    writer.PutBytes(back->Peer());
+    writer.PutBytes(message);
+
+    inner_->HandleMessage(message,
+                          std::make_shared<TracingSocket>(back, tape_));
+  }
+
+  void HandleDisconnect(const std::string& peer) override {
+    auto& writer = tape_->Writer();
+    writer.Begin(EventKind::Disconnect);
+    writer.PutVarint(id_);
+    writer.PutBytes(peer);
+
+    inner_->HandleDisconnect(peer);
+  }
+
+ private:
+  IHandlerPtr inner_;
+  size_t id_;
+  Tape* tape_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class ReplayServer : public IServer {
+ public:
+  void Shutdown() override {
+  }
+};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+TracingTransport::TracingTransport(commute::transport::ITransport* inner,
+                                   Tape* tape)
+    : inner_(inner), tape_(tape) {
+}
+
+const std::string& TracingTransport::HostName() const {
+  return inner_->HostName();
+}
+
+size_t TracingTransport::Register(IHandlerPtr handler) {
+  handlers_.push_back(std::move(handler));
+  return handlers_.size() - 1;
+}
+
+IServerPtr TracingTransport::Serve(const std::string& port,
+                                   IHandlerPtr handler) {
+  if (tape_->Replaying()) {
+    Register(std::move(handler));
+    return std::make_shared<ReplayServer>();
+  }
+
+  size_t id = Register(handler);
+  return inner_->Serve(
+      port, std::make_shared<TracingHandler>(std::move(handler), id, tape_));
+}
+
+ISocketPtr TracingTransport::ConnectTo(const std::string& address,
+                                       IHandlerPtr handler) {
+  if (tape_->Replaying()) {
+    Register(std::move(handler));
+    return std::make_shared<TracingSocket>(address, tape_);
+  }
+
+  size_t id = Register(handler);
+  auto socket = inner_->ConnectTo(
+      address,
+      std::make_shared<TracingHandler>(std::move(handler), id, tape_));
+  return std::make_shared<TracingSocket>(std::move(socket), tape_);
+}
+
+bool TracingTransport::DeliverNext() {
+  WHEELS_VERIFY(tape_->Replaying(), "DeliverNext is replay only");
+
+  auto& reader = tape_->Reader();
+
+  bool message = reader.NextIs(EventKind::Message);
+  if (!message && !reader.NextIs(EventKind::Disconnect)) {
+    return false;
+  }
+  reader.Expect(message ? EventKind::Message : EventKind::Disconnect);
+
+  size_t id = reader.GetVarint();
+  WHEELS_VERIFY(id < handlers_.size(),
+                fmt::format("Replay diverged: delivery to handler {}, "
+                            "{} handlers registered",
+                            id, handlers_.size()));
+  std::string peer{reader.GetBytes()};
+
+  if (message) {
+    // Copy: handler may outlive the mapped trace
+    Message bytes{reader.GetBytes()};
+    handlers_[id]->HandleMessage(
+        bytes, std::make_shared<TracingSocket>(std::move(peer), tape_));
+  } else {
+    handlers_[id]->HandleDisconnect(peer);
+  }
+  return true;
+}
+
+}  // namespace whirl::trace
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <whirl/trace/tape.hpp>
+
+#include <commute/transport/transport.hpp>
+
+#include <string>
+#include <vector>
+
+namespace whirl::trace {
+
+// Records inbound messages and disconnects in delivery order,
+// interleaved with other inputs on the tape
+//
+// Replay does not touch the network: recorded deliveries are injected
+// with DeliverNext, outbound messages are dropped
+//
+// Handlers (Serve / ConnectTo) are numbered in registration order,
+// replayed node registers them in the same order
+
+class TracingTransport : public commute::transport::ITransport {
+ public:
+  TracingTransport(commute::transport::ITransport* inner, Tape* tape);
+
+  const std::string& HostName() const override;
+
+  commute::transport::IServerPtr Serve(
+      const std::string& port,
+      commute::transport::IHandlerPtr handler) override;
+
+  commute::transport::ISocketPtr ConnectTo(
+      const std::string& address,
+      commute::transport::IHandlerPtr handler) override;
+
+  // Replay only
+  // Delivers the next recorded event if it is an inbound message
+  // or a disconnect, returns false otherwise
+  bool DeliverNext();
+
+ private:
+  // Handler id
+  size_t Register(commute::transport::IHandlerPtr handler);
+
+ private:
+  commute::transport::ITransport* inner_;
+  Tape* tape_;
+
+  std::vector<commute::transport::IHandlerPtr> handlers_;
+};
+
+}  // namespace whirl::trace
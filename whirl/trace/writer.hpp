@@ -0,0 +1,46 @@
+#pragma once
+
+#include <whirl/trace/format.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace whirl::trace {
+
+// Appends events to in-memory trace
+
+class TraceWriter {
+ public:
+  TraceWriter();
+
+  // Event = Begin + payload
+  void Begin(EventKind kind);
+
+  void PutVarint(uint64_t value);
+  void PutZigZag(int64_t value);
+  void PutFixed64(uint64_t value);
+  void PutBytes(std::string_view bytes);
+
+  // Delta-encoded clock read
+  void PutClock(EventKind clock, uint64_t value);
+
+  const std::string& Bytes() const {
+    return buffer_;
+  }
+
+  size_t EventCount() const {
+    return events_;
+  }
+
+  // Writes trace to host file
+  void Save(const std::string& path) const;
+
+ private:
+  std::string buffer_;
+  size_t events_ = 0;
+  uint64_t last_wall_ = 0;
+  uint64_t last_monotonic_ = 0;
+};
+
+}  // namespace whirl::trace